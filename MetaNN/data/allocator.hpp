@@ -1,7 +1,17 @@
 #pragma once
 
 #include <data/tags.hpp>
+#include <data/memory_policy.hpp>
+#include <data/memory_block.hpp>
+#include <data/pool_allocator.hpp>
+#include <data/thread_cache_allocator.hpp>
+#include <data/arena_allocator.hpp>
+#include <data/huge_page_allocator.hpp>
 #include <memory>
+#include <new>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
 #include <type_traits>
 
 namespace MetaNN
@@ -10,48 +20,147 @@ namespace MetaNN
 template<typename TDevice>
 struct Allocator;
 
+// 返回的内存块起始地址按alignment对齐
 template<>
 struct Allocator<DeviceTags::CPU>
 {
-    template<typename TElem>
-    static std::shared_ptr<TElem> allocate(size_t elementSize)
+    static RawMemory allocate(std::size_t bytes, std::size_t alignment)
     {
-        return std::shared_ptr<TElem>(new TElem[elementSize], [](TElem* ptr) { delete [] ptr; });
+        void* ptr = ::operator new(bytes, std::align_val_t{alignment});
+        return RawMemory{ptr, bytes, alignment, nullptr, [](const RawMemory& raw) {
+            ::operator delete(raw.ptr, std::align_val_t{raw.alignment});
+        }};
     }
 };
 
+// 根据内存策略选择分配器，策略通过特化DataMemoryPolicy_为元素类型与设备指定
+// TPolicy为选择后的内存策略，供需要其他策略参数的分配器使用
+template<typename TAllocatorTag, typename TDevice, typename TPolicy>
+struct AllocatorFromTag_;
+
+template<typename TDevice, typename TPolicy>
+struct AllocatorFromTag_<MemoryPolicy::AllocatorTypeCategory::Heap, TDevice, TPolicy>
+{
+    using type = Allocator<TDevice>;
+};
+
+template<typename TDevice, typename TPolicy>
+struct AllocatorFromTag_<MemoryPolicy::AllocatorTypeCategory::Pool, TDevice, TPolicy>
+{
+    using type = PoolAllocator<TDevice>;
+};
+
+template<typename TDevice, typename TPolicy>
+struct AllocatorFromTag_<MemoryPolicy::AllocatorTypeCategory::ThreadCache, TDevice, TPolicy>
+{
+    using type = ThreadCacheAllocator<TDevice>;
+};
+
+template<typename TDevice, typename TPolicy>
+struct AllocatorFromTag_<MemoryPolicy::AllocatorTypeCategory::HugePage, TDevice, TPolicy>
+{
+    using type = HugePagePolicyAllocator<TDevice, TPolicy::HugePageThreshold,
+                                         std::is_same_v<typename TPolicy::HugePageMode,
+                                                        MemoryPolicy::HugePageModeTypeCategory::Explicit>>;
+};
+
+template<typename TElem, typename TDevice>
+struct AllocatorOf_
+{
+    using Policy = DataMemoryPolicy<TElem, TDevice>;
+    using type = typename AllocatorFromTag_<typename Policy::Allocator, TDevice, Policy>::type;
+};
+
+template<typename TElem, typename TDevice>
+using AllocatorOf = typename AllocatorOf_<TElem, TDevice>::type;
+
 // 维护Allocator分配的内存
-// 传递内存时同时传递智能指针，确保引用计数的正确性
-// 使用时只使用底层的内存，通常指向智能指针维护内存的开始，但也可能指向中间（比如涉及子矩阵的情况）
+// 采用侵入式引用计数：控制块与数据位于同一次分配中，紧跟在数据之后，只需要一次分配
+// 使用时只使用底层的内存，通常指向内存块的开始，但也可能指向中间（比如涉及子矩阵的情况）
 // 该对象拷贝是浅拷贝，以避免大量数据的深拷贝
 // 读操作可以任意时候进行，但是写操作只能在引用计数为1，也就是无其他地方引用时进行，防止修改了共享了底层内存的其他数据造成错误。
+// 引用计数默认是原子的，单线程使用的数据可以通过内存策略PNonAtomicRefCount选择非原子计数
 template<typename TElem, typename TDevice>
 class ContinuousMemory
 {
     static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type"); // 内存中保存的类型不应该有CVRef限定
     using ElementType = TElem;
+    using Policy = DataMemoryPolicy<TElem, TDevice>;
+    static constexpr bool Tracked = std::is_same_v<typename Policy::Tracking, MemoryPolicy::TrackingTypeCategory::On>;
+    using Header = MemoryBlockHeader<RefCounter<typename Policy::RefCount>, Tracked>;
 public:
-    explicit ContinuousMemory(size_t size)
-        : m_sp(Allocator<TDevice>::template allocate<ElementType>(size))
-        , m_pMemStart(m_sp.get())
+    // tag为创建内存的数据类型，打开内存分配跟踪时用于归属统计
+    explicit ContinuousMemory(size_t size, const char* tag = nullptr)
+        : m_header(allocate(size, tag))
+        , m_pMemStart(static_cast<ElementType*>(m_header->elements))
     {
     }
+    // 与mem共享同一内存块，但起始位置不同，用于构造子矩阵等视图
+    ContinuousMemory(const ContinuousMemory& mem, ElementType* pMemStart)
+        : m_header(mem.m_header)
+        , m_pMemStart(pMemStart)
+    {
+        m_header->refCount.increase();
+    }
+    // 接管由智能指针维护的内存，控制块单独分配
     ContinuousMemory(std::shared_ptr<ElementType> spMem, ElementType* pMemStart)
-        : m_sp(std::move(spMem))
+        : m_header(adopt(pMemStart, std::move(spMem), false))
         , m_pMemStart(pMemStart)
     {
     }
-    auto rawMemory() const
+    // 使用外部内存，keepAlive维持外部内存的生命周期，只读内存的availableForWrite()始终为false
+    // sharedSource为true时同一块外部内存可能由多个控制块引用，它们共享keepAlive，只有keepAlive没有其他持有者时才可写
+    ContinuousMemory(ElementType* pMemStart, std::shared_ptr<void> keepAlive, bool readOnly, bool sharedSource = false)
+        : m_header(adopt(pMemStart, std::move(keepAlive), readOnly, sharedSource))
+        , m_pMemStart(pMemStart)
     {
-        return m_pMemStart;
     }
-    const std::shared_ptr<ElementType> sharedPtr() const
+    ContinuousMemory(const ContinuousMemory& rhs)
+        : m_header(rhs.m_header)
+        , m_pMemStart(rhs.m_pMemStart)
     {
-        return m_sp;
+        if (m_header)
+        {
+            m_header->refCount.increase();
+        }
+    }
+    ContinuousMemory(ContinuousMemory&& rhs) noexcept
+        : m_header(std::exchange(rhs.m_header, nullptr))
+        , m_pMemStart(std::exchange(rhs.m_pMemStart, nullptr))
+    {
+    }
+    ContinuousMemory& operator=(const ContinuousMemory& rhs)
+    {
+        ContinuousMemory tmp(rhs);
+        swap(tmp);
+        return *this;
+    }
+    ContinuousMemory& operator=(ContinuousMemory&& rhs) noexcept
+    {
+        ContinuousMemory tmp(std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+    ~ContinuousMemory()
+    {
+        if (m_header && m_header->refCount.decrease() == 0)
+        {
+            destroy(m_header);
+        }
+    }
+    void swap(ContinuousMemory& rhs) noexcept
+    {
+        std::swap(m_header, rhs.m_header);
+        std::swap(m_pMemStart, rhs.m_pMemStart);
+    }
+
+    auto rawMemory() const
+    {
+        return m_pMemStart;
     }
     bool operator==(const ContinuousMemory& rhs) const
     {
-        return m_sp == rhs.m_sp && m_pMemStart == rhs.m_pMemStart;
+        return m_header == rhs.m_header && m_pMemStart == rhs.m_pMemStart;
     }
     bool operator!=(const ContinuousMemory& rhs) const
     {
@@ -59,11 +168,73 @@ public:
     }
     size_t useCount() const
     {
-        return m_sp.use_count();
+        return m_header ? m_header->refCount.count() : 0;
+    }
+    // 可写：不是只读内存，并且没有被共享
+    bool availableForWrite() const
+    {
+        return m_header && !m_header->readOnly && m_header->refCount.count() == 1 &&
+               (!m_header->sharedSource || m_header->keepAlive.use_count() == 1);
+    }
+private:
+    // 当前线程安装了竞技场时从竞技场分配，否则使用内存策略选择的分配器
+    static RawMemory allocateRaw(std::size_t bytes, std::size_t alignment)
+    {
+        if (auto* arena = ArenaAllocator<TDevice>::active())
+        {
+            return arena->allocate(bytes, alignment);
+        }
+        return AllocatorOf<ElementType, TDevice>::allocate(bytes, alignment);
+    }
+    // 数据在前，控制块在后
+    static Header* allocate(size_t size, [[maybe_unused]] const char* tag)
+    {
+        constexpr std::size_t alignment = std::max(MemoryAlignment<ElementType, TDevice>, alignof(Header));
+        std::size_t headerOffset = (size * sizeof(ElementType) + alignof(Header) - 1) / alignof(Header) * alignof(Header);
+        RawMemory raw = allocateRaw(headerOffset + sizeof(Header), alignment);
+        ElementType* elements = static_cast<ElementType*>(raw.ptr);
+        std::uninitialized_default_construct_n(elements, size);
+        Header* header = ::new (static_cast<std::byte*>(raw.ptr) + headerOffset) Header();
+        header->elements = elements;
+        header->elementCount = size;
+        header->raw = raw;
+        if constexpr (Tracked)
+        {
+            header->track.bytes = size * sizeof(ElementType);
+            header->track.tag = MemoryTracker::recordAllocate(header->track.bytes, tag);
+        }
+        return header;
+    }
+    // 接管的外部内存通常属于长期存在的数据（参数、映射的权重），控制块不从竞技场分配
+    static Header* adopt(ElementType* elements, std::shared_ptr<void> keepAlive, bool readOnly, bool sharedSource = false)
+    {
+        RawMemory raw = AllocatorOf<ElementType, TDevice>::allocate(sizeof(Header), alignof(Header));
+        Header* header = ::new (raw.ptr) Header();
+        header->elements = elements;
+        header->raw = raw;
+        header->keepAlive = std::move(keepAlive);
+        header->readOnly = readOnly;
+        header->sharedSource = sharedSource;
+        return header;
+    }
+    static void destroy(Header* header)
+    {
+        if constexpr (Tracked)
+        {
+            // 接管的外部内存不做跟踪
+            if (header->track.tag)
+            {
+                MemoryTracker::recordFree(header->track.bytes, header->track.tag);
+            }
+        }
+        std::destroy_n(static_cast<ElementType*>(header->elements), header->elementCount);
+        RawMemory raw = header->raw;
+        header->~Header();
+        raw.release();
     }
 private:
-    std::shared_ptr<ElementType> m_sp;
+    Header* m_header;
     ElementType* m_pMemStart;
 };
 
-} // namespace MetaNN
\ No newline at end of file
+} // namespace MetaNN
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/memory_block.hpp>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+
+namespace MetaNN
+{
+
+// 竞技场（bump-pointer）分配器：从大块内存中顺序切分，单个内存块的释放只减少计数，reset时一次性全部回收
+// 用于一轮正向/反向传播中生命周期不超过本轮的中间结果，稳态下每轮迭代不再向堆申请内存
+// 通过ArenaScope为当前线程安装，安装期间当前线程构造的ContinuousMemory都从竞技场中分配
+// 参数矩阵等长期存在的数据必须在ArenaScope之外构造，或者在其中使用PersistentMemoryScope临时恢复为普通分配器
+template<typename TDevice>
+class ArenaAllocator;
+
+template<typename TDevice>
+class ArenaScope;
+
+template<typename TDevice>
+class PersistentMemoryScope;
+
+template<>
+class ArenaAllocator<DeviceTags::CPU>
+{
+    friend class ArenaScope<DeviceTags::CPU>;
+    friend class PersistentMemoryScope<DeviceTags::CPU>;
+
+public:
+    static constexpr std::size_t DefaultChunkSize = 1 << 20;
+
+    explicit ArenaAllocator(std::size_t chunkSize = DefaultChunkSize)
+        : m_chunkSize(chunkSize)
+        , m_liveBlocks(0)
+        , m_curChunk(0)
+        , m_offset(0)
+    {
+    }
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+    // 仍有数据引用竞技场内存时释放大块会留下悬空指针，析构函数不能抛出异常，因此直接终止程序
+    ~ArenaAllocator()
+    {
+        if (m_liveBlocks != 0)
+        {
+            std::fputs("ArenaAllocator destroyed while blocks are still in use.\n", stderr);
+            std::terminate();
+        }
+        freeChunks();
+    }
+
+    RawMemory allocate(std::size_t bytes, std::size_t alignment)
+    {
+        void* ptr = carve(bytes, alignment);
+        ++m_liveBlocks;
+        return RawMemory{ptr, bytes, alignment, this, [](const RawMemory& raw) {
+            --static_cast<ArenaAllocator*>(raw.context)->m_liveBlocks;
+        }};
+    }
+
+    // 一次性回收所有内存块，要求所有从竞技场分配的数据都已经销毁
+    // 如果上一轮用到了多个大块，则合并为一个足够大的块，之后相同规模的迭代只需要一个大块
+    void reset()
+    {
+        if (m_liveBlocks != 0)
+        {
+            throw std::runtime_error("ArenaAllocator reset while blocks are still in use.");
+        }
+        if (m_chunks.size() > 1)
+        {
+            std::size_t total = 0;
+            for (const auto& chunk : m_chunks)
+            {
+                total += chunk.size;
+            }
+            freeChunks();
+            m_chunks.push_back(Chunk{static_cast<std::byte*>(::operator new(total, ChunkAlignment)), total});
+        }
+        m_curChunk = 0;
+        m_offset = 0;
+    }
+
+    // 正在使用的内存块数量
+    std::size_t liveBlocks() const
+    {
+        return m_liveBlocks;
+    }
+    // 从上次reset起切分出去的字节数（含对齐填充）
+    std::size_t usedBytes() const
+    {
+        std::size_t used = m_offset;
+        for (std::size_t i = 0; i < m_curChunk && i < m_chunks.size(); ++i)
+        {
+            used += m_chunks[i].size;
+        }
+        return used;
+    }
+    // 竞技场当前持有的总字节数
+    std::size_t capacity() const
+    {
+        std::size_t total = 0;
+        for (const auto& chunk : m_chunks)
+        {
+            total += chunk.size;
+        }
+        return total;
+    }
+    std::size_t chunkCount() const
+    {
+        return m_chunks.size();
+    }
+
+    // 当前线程安装的竞技场，没有安装时为空
+    static ArenaAllocator* active()
+    {
+        return activeRef();
+    }
+
+private:
+    // 大块按页对齐，从中切分的内存块对齐要求都不会超过页大小
+    static constexpr std::align_val_t ChunkAlignment{4096};
+
+    struct Chunk
+    {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    static ArenaAllocator*& activeRef()
+    {
+        thread_local ArenaAllocator* arena = nullptr;
+        return arena;
+    }
+
+    void* carve(std::size_t bytes, std::size_t alignment)
+    {
+        while (m_curChunk < m_chunks.size())
+        {
+            Chunk& chunk = m_chunks[m_curChunk];
+            std::size_t begin = (m_offset + alignment - 1) & ~(alignment - 1);
+            if (begin + bytes <= chunk.size)
+            {
+                m_offset = begin + bytes;
+                return chunk.data + begin;
+            }
+            ++m_curChunk;
+            m_offset = 0;
+        }
+        std::size_t size = std::max(m_chunkSize, bytes);
+        m_chunks.push_back(Chunk{static_cast<std::byte*>(::operator new(size, ChunkAlignment)), size});
+        m_curChunk = m_chunks.size() - 1;
+        m_offset = bytes;
+        return m_chunks.back().data;
+    }
+
+    void freeChunks()
+    {
+        for (const auto& chunk : m_chunks)
+        {
+            ::operator delete(chunk.data, ChunkAlignment);
+        }
+        m_chunks.clear();
+    }
+
+private:
+    std::size_t m_chunkSize;
+    std::atomic<std::size_t> m_liveBlocks; // 内存块可能在其他线程释放
+    std::vector<Chunk> m_chunks;
+    std::size_t m_curChunk;
+    std::size_t m_offset;
+};
+
+// 在作用域内为当前线程安装竞技场，可以嵌套，析构时恢复之前安装的竞技场
+template<typename TDevice>
+class ArenaScope
+{
+public:
+    explicit ArenaScope(ArenaAllocator<TDevice>& arena)
+        : m_prev(ArenaAllocator<TDevice>::activeRef())
+    {
+        ArenaAllocator<TDevice>::activeRef() = &arena;
+    }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    ~ArenaScope()
+    {
+        ArenaAllocator<TDevice>::activeRef() = m_prev;
+    }
+private:
+    ArenaAllocator<TDevice>* m_prev;
+};
+
+// 在作用域内临时卸载当前线程的竞技场，用于在ArenaScope内部构造长期存在的数据（比如参数矩阵）
+template<typename TDevice>
+class PersistentMemoryScope
+{
+public:
+    PersistentMemoryScope()
+        : m_prev(ArenaAllocator<TDevice>::activeRef())
+    {
+        ArenaAllocator<TDevice>::activeRef() = nullptr;
+    }
+    PersistentMemoryScope(const PersistentMemoryScope&) = delete;
+    PersistentMemoryScope& operator=(const PersistentMemoryScope&) = delete;
+    ~PersistentMemoryScope()
+    {
+        ArenaAllocator<TDevice>::activeRef() = m_prev;
+    }
+private:
+    ArenaAllocator<TDevice>* m_prev;
+};
+
+} // namespace MetaNN
@@ -1,8 +1,14 @@
 #pragma once
 
 #include <data/traits.hpp>
+#include <data/eval_cache.hpp>
+#include <data/matrix/matrix_view.hpp>
+#include <data/batch/batch.hpp>
+#include <algorithm>
 #include <type_traits>
 #include <concepts>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <stdexcept>
 #include <iterator>
@@ -12,9 +18,73 @@ namespace MetaNN
 {
 
 // Batch是不可变的列表，而Array是可变列表（话说用Array命名可变列表会不会有点怪？）
+// Array的每个元素各自占有存储，求值时依次复制到一个连续存储的Batch中（materialize()），按列表处理的运算只访问这一块内存
+// 求值结果缓存在对象中并在拷贝之间共享，数组被修改（push_back、clear以及可能写入元素的非const访问）时丢弃
+// 注意：非const的operator[]、begin()、end()返回的引用应在下一次求值前用完，通过求值之前得到的引用写入不会更新缓存
 template<typename TData>
 class Array;
 
+namespace NsArray
+{
+
+// 并行收集时每个线程至少负责的元素个数，更小的数组由当前线程直接复制，避免创建线程的开销超过复制本身
+constexpr std::size_t ParallelGatherGrain = std::size_t(1) << 18;
+
+// 收集elemNum个元素使用的线程数
+inline std::size_t gatherThreadNum(std::size_t elemNum)
+{
+    const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    return std::clamp<std::size_t>(elemNum / ParallelGatherGrain, 1, hardware);
+}
+
+// 把[0, num)均匀地分为threadNum段，分别调用func(begin, end)，最后一段在当前线程中处理
+template<typename TFunc>
+void parallelRanges(std::size_t num, std::size_t threadNum, const TFunc& func)
+{
+    threadNum = std::clamp<std::size_t>(threadNum, 1, std::max<std::size_t>(num, 1));
+    const std::size_t baseLen = num / threadNum;
+    const std::size_t extra = num % threadNum;
+    std::vector<std::thread> threads;
+    threads.reserve(threadNum - 1);
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i + 1 < threadNum; ++i)
+    {
+        const std::size_t end = begin + baseLen + (i < extra ? 1 : 0);
+        threads.emplace_back(func, begin, end);
+        begin = end;
+    }
+    func(begin, num);
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+}
+
+// 复制一个矩阵，源矩阵的视图可以是MatrixView或者BroadcastView
+template<typename TElem, typename TSrcView>
+void copyMatrix(const TSrcView& src, const MatrixView<TElem>& dest)
+{
+    assert(src.rowNum() == dest.rowNum() && src.colNum() == dest.colNum());
+    for (std::size_t i = 0; i < dest.rowNum(); ++i)
+    {
+        if constexpr (requires { std::span(src.row(i)); })
+        {
+            if (src.isRowContiguous())
+            {
+                auto row = src.row(i);
+                std::copy(row.begin(), row.end(), dest.row(i).begin());
+                continue;
+            }
+        }
+        for (std::size_t j = 0; j < dest.colNum(); ++j)
+        {
+            dest(i, j) = src(i, j);
+        }
+    }
+}
+
+} // namespace NsArray
+
 // 标量数组
 template<typename TData> requires std::same_as<DataCategory<TData>, CategoryTags::Scalar>
 class Array<TData>
@@ -53,6 +123,7 @@ public:
     void push_back(TData val)
     {
         assert(availableForWrite());
+        m_cache.reset();
         m_buffer->emplace_back(std::move(val));
     }
     template<typename... Args>
@@ -60,6 +131,7 @@ public:
     {
         assert(availableForWrite());
         TData tmp(std::forward<Args>(args)...);
+        m_cache.reset();
         m_buffer->emplace_back(std::move(tmp));
     }
     void reserve(std::size_t num)
@@ -70,6 +142,7 @@ public:
     void clear()
     {
         assert(availableForWrite());
+        m_cache.reset();
         m_buffer->clear();
     }
     bool empty() const
@@ -80,12 +153,15 @@ public:
     {
         return (*m_buffer)[idx];
     }
+    // 返回的引用可能被用于写入，因此丢弃缓存
     auto& operator[](std::size_t idx)
     {
+        m_cache.reset();
         return (*m_buffer)[idx];
     }
     auto begin()
     {
+        m_cache.reset();
         return m_buffer->begin();
     }
     auto begin() const
@@ -94,6 +170,7 @@ public:
     }
     auto end()
     {
+        m_cache.reset();
         return m_buffer->end();
     }
     auto end() const
@@ -101,10 +178,28 @@ public:
         return m_buffer->end();
     }
 
-    // 求值接口: todo
+    // 求值接口
+    // 各元素依次复制到一个连续存储的标量列表中，结果缓存到数组被修改为止
+    Batch<ElementType, DeviceType, CategoryTags::Scalar> materialize() const
+    {
+        return m_cache.get([this]() {
+            Batch<ElementType, DeviceType, CategoryTags::Scalar> res(size());
+            auto dest = res.mutableView();
+            for (std::size_t i = 0; i < size(); ++i)
+            {
+                dest[i] = (*m_buffer)[i].value();
+            }
+            return res;
+        });
+    }
+    bool materialized() const
+    {
+        return m_cache.cached();
+    }
 private:
     std::shared_ptr<std::vector<TData>> m_buffer;
-    // 求值缓存: todo
+    // 求值缓存
+    EvalCache<Batch<ElementType, DeviceType, CategoryTags::Scalar>> m_cache;
 };
 
 // 矩阵数组
@@ -133,7 +228,7 @@ public:
         if (!buffer.empty())
         {
             m_rowNum = buffer[0].rowNum();
-            m_colNum = buffer[1].colNum();
+            m_colNum = buffer[0].colNum();
             for (std::size_t i = 1; i < buffer.size(); ++i)
             {
                 if (buffer[i].rowNum() != m_rowNum || buffer[i].colNum() != m_colNum)
@@ -172,6 +267,7 @@ public:
         {
             throw std::runtime_error("Dimension mismatch");
         }
+        m_cache.reset();
         m_buffer->push_back(std::move(mat));
     }
     template<typename... Args>
@@ -183,6 +279,7 @@ public:
         {
             throw std::runtime_error("Dimension mismatch");
         }
+        m_cache.reset();
         m_buffer->emplace_back(std::move(tmp));
     }
     void reserve(std::size_t num)
@@ -193,6 +290,7 @@ public:
     void clear()
     {
         assert(availableForWrite());
+        m_cache.reset();
         m_buffer->clear();
     }
     bool empty() const
@@ -203,12 +301,15 @@ public:
     {
         return (*m_buffer)[idx];
     }
+    // 返回的引用可能被用于写入，因此丢弃缓存
     auto& operator[](std::size_t idx)
     {
+        m_cache.reset();
         return (*m_buffer)[idx];
     }
     auto begin()
     {
+        m_cache.reset();
         return m_buffer->begin();
     }
     auto begin() const
@@ -217,6 +318,7 @@ public:
     }
     auto end()
     {
+        m_cache.reset();
         return m_buffer->end();
     }
     auto end() const
@@ -224,13 +326,40 @@ public:
         return m_buffer->end();
     }
 
-    // 求值接口: todo
+    // 求值接口
+    // 各矩阵依次复制到一个连续存储的矩阵列表中，结果缓存到数组被修改为止
+    // 元素总数较多时由多个线程分段复制（见NsArray::gatherThreadNum）
+    Batch<ElementType, DeviceType, CategoryTags::Matrix> materialize() const
+    {
+        return m_cache.get([this]() {
+            return gather(NsArray::gatherThreadNum(size() * m_rowNum * m_colNum));
+        });
+    }
+    bool materialized() const
+    {
+        return m_cache.cached();
+    }
+    // 使用threadNum个线程复制到新的矩阵列表中，不经过缓存
+    Batch<ElementType, DeviceType, CategoryTags::Matrix> gather(std::size_t threadNum) const
+    {
+        Batch<ElementType, DeviceType, CategoryTags::Matrix> res(size(), m_rowNum, m_colNum);
+        const auto dest = res.mutableView();
+        const auto& buffer = *m_buffer;
+        NsArray::parallelRanges(size(), threadNum, [&dest, &buffer](std::size_t begin, std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b)
+            {
+                NsArray::copyMatrix(buffer[b].view(), dest[b]);
+            }
+        });
+        return res;
+    }
 
 private:
     std::size_t m_rowNum;
     std::size_t m_colNum;
     std::shared_ptr<std::vector<TData>> m_buffer;
-    // 求值缓存: todo
+    // 求值缓存
+    EvalCache<Batch<ElementType, DeviceType, CategoryTags::Matrix>> m_cache;
 };
 
 // 快捷构造Array
@@ -4,6 +4,12 @@
 #include <data/lower_access.hpp>
 #include <data/allocator.hpp>
 #include <data/matrix/matrix.hpp>
+#include <data/copy_on_write.hpp>
+#include <span>
+#include <algorithm>
+#include <vector>
+#include <concepts>
+#include <cstdint>
 #include <cassert>
 
 namespace MetaNN
@@ -36,7 +42,13 @@ public:
     using DeviceType = DeviceTags::CPU;
 public:
     Batch(std::size_t length = 0)
-        : m_mem(length)
+        : m_mem(length, "Batch<Scalar>")
+        , m_len(length)
+    {
+    }
+    // 在给定的内存上构造标量列表，共享存储
+    Batch(ContinuousMemory<ElementType, DeviceType> mem, std::size_t length)
+        : m_mem(std::move(mem))
         , m_len(length)
     {
     }
@@ -48,13 +60,16 @@ public:
     }
     bool availableForWrite() const
     {
-        return m_mem.useCount() == 1;
+        return m_mem.availableForWrite();
     }
-    // 写入接口
+    // 写入接口：写时复制，底层内存被共享时先脱离共享
     void setValue(std::size_t index, ElementType val)
     {
-        assert(availableForWrite());
         assert(index < m_len);
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
         m_mem.rawMemory()[index] = val;
     }
     // 读取接口
@@ -63,9 +78,37 @@ public:
         assert(index < m_len);
         return m_mem.rawMemory()[index];
     }
+    // 批量访问视图，含义同Matrix::view()与Matrix::mutableView()
+    std::span<const ElementType> view() const
+    {
+        return std::span<const ElementType>(m_mem.rawMemory(), m_len);
+    }
+    std::span<ElementType> mutableView()
+    {
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        return std::span<ElementType>(m_mem.rawMemory(), m_len);
+    }
+
+    // 第[batchBegin, batchEnd)个标量组成的子列表，浅拷贝，共享存储
+    Batch subBatch(std::size_t batchBegin, std::size_t batchEnd) const
+    {
+        assert(batchBegin <= batchEnd && batchEnd <= m_len);
+        return Batch(ContinuousMemory<ElementType, DeviceType>(m_mem, m_mem.rawMemory() + batchBegin), batchEnd - batchBegin);
+    }
 
     // 求值接口: todo
 private:
+    void detach()
+    {
+        ContinuousMemory<ElementType, DeviceType> mem(m_len, "Batch<Scalar>");
+        std::copy(m_mem.rawMemory(), m_mem.rawMemory() + m_len, mem.rawMemory());
+        m_mem = std::move(mem);
+        CopyOnWrite::recordDetach<Category>(m_len * sizeof(ElementType));
+    }
+
     ContinuousMemory<ElementType, DeviceType> m_mem;
     std::size_t m_len;
 };
@@ -74,6 +117,9 @@ private:
 template<typename TElem>
 struct LowerAccessImpl<Batch<TElem, DeviceTags::CPU, CategoryTags::Scalar>>
 {
+    // 底层内存块起始地址的对齐字节数，含义同LowerAccessImpl<Matrix>::Alignment
+    static constexpr std::size_t Alignment = MemoryAlignment<TElem, DeviceTags::CPU>;
+
     LowerAccessImpl(Batch<TElem, DeviceTags::CPU, CategoryTags::Scalar> p)
         : m_data(std::move(p))
     {
@@ -86,6 +132,10 @@ struct LowerAccessImpl<Batch<TElem, DeviceTags::CPU, CategoryTags::Scalar>>
     {
         return m_data.m_mem.rawMemory();
     }
+    bool isAligned() const
+    {
+        return reinterpret_cast<std::uintptr_t>(rawMemory()) % Alignment == 0;
+    }
 private:
     Batch<TElem, DeviceTags::CPU, CategoryTags::Scalar> m_data;
 };
@@ -102,14 +152,41 @@ public:
     using ElementType = TElem;
     using DeviceType = DeviceTags::CPU;
 public:
+    // 矩阵的行长度按内存策略的RowAlignment填充，各矩阵依次排列，因此每个矩阵的每一行都从对齐的地址开始
     Batch(std::size_t batchNum = 0, std::size_t row = 0, std::size_t col = 0)
-        : m_mem(row * col * batchNum)
+        : m_mem(row * paddedRowLen<ElementType, DeviceType>(col) * batchNum, "Batch<Matrix>")
         , m_rowNum(row)
         , m_colNum(col)
         , m_batchNum(batchNum)
-        , m_rowLen(col)
-        , m_rawMatrixSize(row * col)
+        , m_rowLen(paddedRowLen<ElementType, DeviceType>(col))
+        , m_colStride(1)
+        , m_rawMatrixSize(row * m_rowLen)
+    {
+    }
+    // 在给定的内存上构造矩阵列表，共享存储，各矩阵紧密排列
+    Batch(ContinuousMemory<ElementType, DeviceType> mem, std::size_t batchNum, std::size_t row, std::size_t col)
+        : Batch(std::move(mem), batchNum, row, col, col, row * col)
+    {
+    }
+    // 在给定的内存上构造矩阵列表，共享存储，rowLen是矩阵相邻两行的间隔，matrixSize是相邻两个矩阵的间隔
+    // colStride是矩阵同一行相邻两个元素的间隔（均为元素数量）
+    Batch(ContinuousMemory<ElementType, DeviceType> mem, std::size_t batchNum, std::size_t row, std::size_t col,
+        std::size_t rowLen, std::size_t matrixSize, std::size_t colStride = 1)
+        : m_mem(std::move(mem))
+        , m_rowNum(row)
+        , m_colNum(col)
+        , m_batchNum(batchNum)
+        , m_rowLen(rowLen)
+        , m_colStride(colStride)
+        , m_rawMatrixSize(matrixSize)
+    {
+        assert(colStride != 1 || rowLen >= col);
+    }
+    // 把mat重复batchNum次构成的列表：相邻矩阵的间隔为0，所有矩阵共享mat的存储，不复制数据
+    // 写入时先复制出batchNum个独立的矩阵（见availableForWrite()）
+    static Batch duplicate(const Matrix<ElementType, DeviceType>& mat, std::size_t batchNum)
     {
+        return Batch(mat.m_mem, batchNum, mat.m_rowNum, mat.m_colNum, mat.m_rowLen, 0, mat.m_colStride);
     }
     // 查询接口
     std::size_t rowNum() const
@@ -124,46 +201,100 @@ public:
     {
         return m_batchNum;
     }
+    // 多个矩阵共享同一存储（矩阵间隔为0）时不能直接写入，否则写入一个矩阵会改变所有矩阵
     bool availableForWrite() const
     {
-        return m_mem.useCount() == 1;
+        return m_mem.availableForWrite() && (m_rawMatrixSize != 0 || m_batchNum <= 1 || m_rowNum * m_colNum == 0);
     }
-    // 写入接口：写入具体的某个矩阵的某个值
+    // 写入接口：写入具体的某个矩阵的某个值，写时复制，底层内存被共享时先脱离共享
     void setValue(std::size_t batchId, std::size_t row, std::size_t col, ElementType val)
     {
-        assert(availableForWrite());
         assert(row < m_rowNum && col < m_colNum && batchId < m_batchNum);
-        m_mem.rawMemory()[batchId * m_rawMatrixSize + row * m_rowLen + col] = val;
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        m_mem.rawMemory()[batchId * m_rawMatrixSize + row * m_rowLen + col * m_colStride] = val;
     }
     // 读取接口：返回一个临时矩阵，共享存储，仅用于访问
     const auto operator[](std::size_t batchId) const
     {
         assert(batchId < m_batchNum);
         auto pos = m_mem.rawMemory() + batchId * m_rawMatrixSize;
-        return Matrix<ElementType, DeviceType>(m_mem.sharedPtr(), pos, m_rowNum, m_colNum, m_rowLen);
+        return Matrix<ElementType, DeviceType>(ContinuousMemory<ElementType, DeviceType>(m_mem, pos), m_rowNum, m_colNum, m_rowLen, m_colStride);
     }
 
     // 子矩阵列表接口，浅拷贝，共享存储，区间前闭后开
     auto subBatchMatrix(std::size_t rowBegin, std::size_t rowEnd, std::size_t colBegin, std::size_t colEnd)
     {
         assert(rowBegin < m_rowNum && colBegin < m_colNum);
-        assert(rowend <= m_rowNum && colEnd <= m_colNum);
-        auto pos = m_mem.rawMemory() + rowBegin * m_rowLen + colBegin;
-        return Batch(m_mem.sharedPtr(), pos, rowEnd - rowBegin, colEnd - colBegin, m_batchNum, m_rowLen, m_rawMatrixSize);
+        assert(rowEnd <= m_rowNum && colEnd <= m_colNum);
+        auto pos = m_mem.rawMemory() + rowBegin * m_rowLen + colBegin * m_colStride;
+        return Batch(ContinuousMemory<ElementType, DeviceType>(m_mem, pos), m_batchNum, rowEnd - rowBegin, colEnd - colBegin,
+                     m_rowLen, m_rawMatrixSize, m_colStride);
+    }
+
+    // 第[batchBegin, batchEnd)个矩阵组成的子列表，浅拷贝，共享存储，保持原有的行间隔与矩阵间隔
+    Batch subBatch(std::size_t batchBegin, std::size_t batchEnd) const
+    {
+        assert(batchBegin <= batchEnd && batchEnd <= m_batchNum);
+        auto pos = m_mem.rawMemory() + batchBegin * m_rawMatrixSize;
+        return Batch(ContinuousMemory<ElementType, DeviceType>(m_mem, pos), batchEnd - batchBegin, m_rowNum, m_colNum,
+                     m_rowLen, m_rawMatrixSize, m_colStride);
+    }
+
+    // 批量访问视图，含义同Matrix::view()与Matrix::mutableView()
+    BatchMatrixView<const ElementType> view() const
+    {
+        return BatchMatrixView<const ElementType>(m_mem.rawMemory(), m_batchNum, m_rowNum, m_colNum,
+                                                  m_rawMatrixSize, m_rowLen, m_colStride);
+    }
+    BatchMatrixView<ElementType> mutableView()
+    {
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        return BatchMatrixView<ElementType>(m_mem.rawMemory(), m_batchNum, m_rowNum, m_colNum,
+                                            m_rawMatrixSize, m_rowLen, m_colStride);
+    }
+
+    // 转置视图：转置其中每一个矩阵，浅拷贝，共享存储空间，不复制数据
+    // 矩阵只有一行时行长度的取法同Matrix::transpose()
+    Batch transpose() const
+    {
+        const std::size_t rowLen = (m_colNum == 1) ? std::max(m_colStride, m_rowNum) : m_colStride;
+        return Batch(m_mem, m_batchNum, m_colNum, m_rowNum, rowLen, m_rawMatrixSize, m_rowLen);
     }
 
     // 求值接口: todo
 
 private:
-    Batch(std::shared_ptr<ElementType> sp, ElementType* pMemStart,
-        std::size_t row, std::size_t col, std::size_t batchNum, std::size_t rowLen, std::size_t matrixSize)
-        : m_mem(sp, pMemStart)
-        , m_rowNum(row)
-        , m_colNum(col)
-        , m_batchNum(batchNum)
-        , m_rowLen(rowLen)
-        , m_rawMatrixSize(matrixSize)
+    // 复制出可见部分的私有副本，副本的布局与新构造的矩阵列表相同
+    void detach()
     {
+        const std::size_t rowLen = paddedRowLen<ElementType, DeviceType>(m_colNum);
+        const std::size_t matrixSize = m_rowNum * rowLen;
+        ContinuousMemory<ElementType, DeviceType> mem(m_batchNum * matrixSize, "Batch<Matrix>");
+        ElementType* pDest = mem.rawMemory();
+        for (std::size_t b = 0; b < m_batchNum; ++b)
+        {
+            const ElementType* pSrc = m_mem.rawMemory() + b * m_rawMatrixSize;
+            for (std::size_t i = 0; i < m_rowNum; ++i)
+            {
+                for (std::size_t j = 0; j < m_colNum; ++j)
+                {
+                    pDest[j] = pSrc[j * m_colStride];
+                }
+                pSrc += m_rowLen;
+                pDest += rowLen;
+            }
+        }
+        m_mem = std::move(mem);
+        m_rowLen = rowLen;
+        m_colStride = 1;
+        m_rawMatrixSize = matrixSize;
+        CopyOnWrite::recordDetach<Category>(m_batchNum * matrixSize * sizeof(ElementType));
     }
 
     ContinuousMemory<ElementType, DeviceType> m_mem; // 内部数据存储于一维数组，并使用ContinuousMemory维护
@@ -171,13 +302,39 @@ private:
     std::size_t m_colNum;
     std::size_t m_batchNum;
     std::size_t m_rowLen;
-    std::size_t m_rawMatrixSize; // 原始的矩阵大小，也就是原始的矩阵行列之积
+    std::size_t m_colStride;
+    std::size_t m_rawMatrixSize; // 相邻两个矩阵起始位置的间隔，新构造时为行数与（填充后的）行长度之积
 };
 
+// 将列表均匀地分为partNum个共享存储的子列表，依次覆盖整个列表，各部分的长度相差不超过1
+// 可用于把大的列表分成多个小批次逐个处理（使中间结果留在缓存中），或者交给多个线程分别处理
+// partNum大于列表长度时靠后的部分为空列表
+template<typename TBatch>
+    requires requires(const TBatch& batch) { { batch.subBatch(0, 0) } -> std::same_as<TBatch>; }
+std::vector<TBatch> splitBatch(const TBatch& batch, std::size_t partNum)
+{
+    assert(partNum > 0);
+    const std::size_t baseLen = batch.batchNum() / partNum;
+    const std::size_t extra = batch.batchNum() % partNum;
+    std::vector<TBatch> res;
+    res.reserve(partNum);
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < partNum; ++i)
+    {
+        const std::size_t end = begin + baseLen + (i < extra ? 1 : 0);
+        res.push_back(batch.subBatch(begin, end));
+        begin = end;
+    }
+    return res;
+}
+
 // 矩阵列表底层访问
 template<typename TElem>
 struct LowerAccessImpl<Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix>>
 {
+    // 底层内存块起始地址的对齐字节数，含义同LowerAccessImpl<Matrix>::Alignment
+    static constexpr std::size_t Alignment = MemoryAlignment<TElem, DeviceTags::CPU>;
+
     LowerAccessImpl(Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> p)
         : m_data(std::move(p))
     {
@@ -190,10 +347,19 @@ struct LowerAccessImpl<Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix>>
     {
         return m_data.m_mem.rawMemory();
     }
+    bool isAligned() const
+    {
+        return reinterpret_cast<std::uintptr_t>(rawMemory()) % Alignment == 0;
+    }
     std::size_t rowLen() const
     {
         return m_data.m_rowLen;
     }
+    // 矩阵同一行相邻两个元素的间隔，含义同LowerAccessImpl<Matrix>::colStride
+    std::size_t colStride() const
+    {
+        return m_data.m_colStride;
+    }
     std::size_t rawMatrixSize() const
     {
         return m_data.m_rawMatrixSize;
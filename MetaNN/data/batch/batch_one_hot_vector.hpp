@@ -0,0 +1,121 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <data/allocator.hpp>
+#include <data/eval_cache.hpp>
+#include <data/matrix/one_hot_vector.hpp>
+#include <data/batch/batch.hpp>
+#include <algorithm>
+#include <span>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 独热向量列表：每个元素是1 * colNum的独热向量，只保存各自的hotPos，常用于成批的类别标签与词元输入
+// 与矩阵相乘时按hotPos取出对应的行（见dot.hpp），负对数似然及其导数只访问hotPos处的元素
+// 确实需要稠密形式时由materialize()生成，结果缓存在对象中并在拷贝之间共享
+template<typename TElem, typename TDevice = DeviceTags::CPU>
+class BatchOneHotVector;
+
+template<typename TElem>
+class BatchOneHotVector<TElem, DeviceTags::CPU>
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type");
+public:
+    using Category = CategoryTags::BatchMatrix;
+    using ElementType = TElem;
+    using DeviceType = DeviceTags::CPU;
+public:
+    // 在给定的内存上构造，共享存储：hotPos依次存放batchNum个位置
+    BatchOneHotVector(std::size_t col, ContinuousMemory<std::size_t, DeviceType> hotPos, std::size_t batchNum)
+        : m_colNum(col)
+        , m_batchNum(batchNum)
+        , m_hotPos(std::move(hotPos))
+    {
+        assert(std::all_of(m_hotPos.rawMemory(), m_hotPos.rawMemory() + batchNum, [col](std::size_t pos) { return pos < col; }));
+    }
+    // 复制给定的位置
+    BatchOneHotVector(std::size_t col, std::span<const std::size_t> hotPos)
+        : BatchOneHotVector(col, copyPositions(hotPos), hotPos.size())
+    {
+    }
+
+    // 查询接口
+    std::size_t rowNum() const
+    {
+        return 1;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    std::size_t batchNum() const
+    {
+        return m_batchNum;
+    }
+    std::size_t hotPos(std::size_t batchId) const
+    {
+        assert(batchId < m_batchNum);
+        return m_hotPos.rawMemory()[batchId];
+    }
+    // 全部位置
+    std::span<const std::size_t> hotPositions() const
+    {
+        return std::span<const std::size_t>(m_hotPos.rawMemory(), m_batchNum);
+    }
+    const auto operator[](std::size_t batchId) const
+    {
+        return OneHotVector<ElementType, DeviceType>(m_colNum, hotPos(batchId));
+    }
+
+    // 求值接口
+    // 稠密形式，第一次调用时生成
+    Batch<ElementType, DeviceType, CategoryTags::Matrix> materialize() const
+    {
+        return m_cache.get([this]() {
+            Batch<ElementType, DeviceType, CategoryTags::Matrix> res(m_batchNum, 1, m_colNum);
+            auto dest = res.mutableView();
+            for (std::size_t b = 0; b < m_batchNum; ++b)
+            {
+                auto row = dest[b].row(0);
+                std::fill(row.begin(), row.end(), ElementType{});
+                row[hotPos(b)] = ElementType(1);
+            }
+            return res;
+        });
+    }
+    bool materialized() const
+    {
+        return m_cache.cached();
+    }
+
+private:
+    static ContinuousMemory<std::size_t, DeviceType> copyPositions(std::span<const std::size_t> hotPos)
+    {
+        ContinuousMemory<std::size_t, DeviceType> res(hotPos.size(), "BatchOneHotVector");
+        std::copy(hotPos.begin(), hotPos.end(), res.rawMemory());
+        return res;
+    }
+
+private:
+    std::size_t m_colNum;
+    std::size_t m_batchNum;
+    ContinuousMemory<std::size_t, DeviceType> m_hotPos;
+    // 求值结果缓存
+    EvalCache<Batch<ElementType, DeviceType, CategoryTags::Matrix>> m_cache;
+};
+
+template<typename T>
+struct IsBatchOneHotVector_ : std::false_type {};
+
+template<typename TElem, typename TDevice>
+struct IsBatchOneHotVector_<BatchOneHotVector<TElem, TDevice>> : std::true_type {};
+
+template<typename T>
+concept BatchOneHotVectorC = IsBatchOneHotVector_<std::remove_cvref_t<T>>::value;
+
+} // namespace MetaNN
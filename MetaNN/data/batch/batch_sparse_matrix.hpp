@@ -0,0 +1,132 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <data/allocator.hpp>
+#include <data/matrix/sparse_matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 稀疏矩阵列表：所有矩阵的非零元素依次存放在同一组CSR数组中
+// rowOffsets共batchNum * rowNum + 1个，第b个矩阵的第i行对应rowOffsets[b * rowNum + i]
+// 取出的单个矩阵与列表共享存储，不复制非零元素
+// 与稠密矩阵列表的乘法逐个矩阵只访问非零元素；其他运算求值时展开为稠密矩阵列表（见evaluate.hpp）
+template<typename TElem>
+class BatchSparseMatrix<TElem, DeviceTags::CPU>
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type");
+public:
+    using Category = CategoryTags::BatchMatrix;
+    using ElementType = TElem;
+    using DeviceType = DeviceTags::CPU;
+public:
+    BatchSparseMatrix(std::size_t batchNum, std::size_t row, std::size_t col,
+                      ContinuousMemory<std::size_t, DeviceType> rowOffsets,
+                      ContinuousMemory<std::size_t, DeviceType> colIndices,
+                      ContinuousMemory<ElementType, DeviceType> values)
+        : m_batchNum(batchNum)
+        , m_rowNum(row)
+        , m_colNum(col)
+        , m_rowOffsets(std::move(rowOffsets))
+        , m_colIndices(std::move(colIndices))
+        , m_values(std::move(values))
+    {
+    }
+
+    // 查询接口
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    std::size_t batchNum() const
+    {
+        return m_batchNum;
+    }
+    std::size_t nonZeroCount() const
+    {
+        return m_rowOffsets.rawMemory()[m_batchNum * m_rowNum] - m_rowOffsets.rawMemory()[0];
+    }
+    // 读取接口：返回共享存储的稀疏矩阵
+    const auto operator[](std::size_t batchId) const
+    {
+        assert(batchId < m_batchNum);
+        auto pos = m_rowOffsets.rawMemory() + batchId * m_rowNum;
+        return SparseMatrix<ElementType, DeviceType>(m_rowNum, m_colNum,
+                                                     ContinuousMemory<std::size_t, DeviceType>(m_rowOffsets, pos),
+                                                     m_colIndices, m_values);
+    }
+    // 第batchId个矩阵的批量访问视图
+    SparseMatrixView<const ElementType> view(std::size_t batchId) const
+    {
+        assert(batchId < m_batchNum);
+        return SparseMatrixView<const ElementType>(m_rowNum, m_colNum, m_rowOffsets.rawMemory() + batchId * m_rowNum,
+                                                   m_colIndices.rawMemory(), m_values.rawMemory());
+    }
+
+private:
+    std::size_t m_batchNum;
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+    ContinuousMemory<std::size_t, DeviceType> m_rowOffsets;
+    ContinuousMemory<std::size_t, DeviceType> m_colIndices;
+    ContinuousMemory<ElementType, DeviceType> m_values;
+};
+
+template<typename T>
+struct IsBatchSparseMatrix_ : std::false_type {};
+
+template<typename TElem, typename TDevice>
+struct IsBatchSparseMatrix_<BatchSparseMatrix<TElem, TDevice>> : std::true_type {};
+
+template<typename T>
+concept BatchSparseMatrixC = IsBatchSparseMatrix_<std::remove_cvref_t<T>>::value;
+
+// 稠密矩阵列表转换为稀疏矩阵列表
+template<typename TBatch>
+    requires IsBatchMatrixC<TBatch>
+auto makeSparse(const TBatch& dense)
+{
+    using ElementType = typename TBatch::ElementType;
+    std::size_t nonZeros = 0;
+    for (std::size_t b = 0; b < dense.batchNum(); ++b)
+    {
+        nonZeros += NsSparse::countNonZeros(dense[b]);
+    }
+    ContinuousMemory<std::size_t, DeviceTags::CPU> offsetMem(dense.batchNum() * dense.rowNum() + 1, "BatchSparseMatrix");
+    ContinuousMemory<std::size_t, DeviceTags::CPU> indexMem(nonZeros, "BatchSparseMatrix");
+    ContinuousMemory<ElementType, DeviceTags::CPU> valueMem(nonZeros, "BatchSparseMatrix");
+    offsetMem.rawMemory()[0] = 0;
+    std::size_t pos = 0;
+    for (std::size_t b = 0; b < dense.batchNum(); ++b)
+    {
+        // 相邻矩阵的边界位置由前一个矩阵写入的结束位置与后一个矩阵写入的起始位置共用，二者相等
+        pos += NsSparse::fillCsr(dense[b], pos, offsetMem.rawMemory() + b * dense.rowNum(),
+                                 indexMem.rawMemory() + pos, valueMem.rawMemory() + pos);
+    }
+    return BatchSparseMatrix<ElementType, DeviceTags::CPU>(dense.batchNum(), dense.rowNum(), dense.colNum(),
+                                                           std::move(offsetMem), std::move(indexMem), std::move(valueMem));
+}
+
+// 稀疏矩阵列表转换为稠密矩阵列表
+template<typename TElem>
+Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> makeDense(const BatchSparseMatrix<TElem, DeviceTags::CPU>& sparse)
+{
+    Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> res(sparse.batchNum(), sparse.rowNum(), sparse.colNum());
+    auto dest = res.mutableView();
+    for (std::size_t b = 0; b < sparse.batchNum(); ++b)
+    {
+        NsSparse::scatter(dest[b], sparse.view(b));
+    }
+    return res;
+}
+
+} // namespace MetaNN
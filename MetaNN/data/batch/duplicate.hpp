@@ -2,6 +2,7 @@
 
 #include <data/tags.hpp>
 #include <data/traits.hpp>
+#include <type_traits>
 #include <cassert>
 
 namespace MetaNN
@@ -40,7 +41,7 @@ public:
         return m_data;
     }
 
-    // 求值接口: todo
+    // 求值结果为填充了该标量的标量列表，见evaluate/broadcast.hpp
 private:
     TData m_data;
     std::size_t m_batchNum;
@@ -81,14 +82,22 @@ public:
         return m_data;
     }
 
-    // 求值接口: todo
+    // 求值结果为矩阵间隔为0、共享被重复矩阵存储的矩阵列表，不需要缓存，见evaluate/broadcast.hpp
 
 private:
     TData m_data;
     std::size_t m_batchNum;
-    // 求值缓存: todo
 };
 
+template<typename T>
+struct IsDuplicate_ : std::false_type {};
+
+template<typename TData>
+struct IsDuplicate_<Duplicate<TData>> : std::true_type {};
+
+template<typename T>
+concept DuplicateC = IsDuplicate_<std::remove_cvref_t<T>>::value;
+
 // 快捷构造Duplicate
 template<typename TData> requires ScalarC<TData> || MatrixC<TData>
 auto makeDuplicate(std::size_t batchNum, TData&& data) 
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <data/allocator.hpp>
+#include <data/copy_on_write.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/matrix_view.hpp>
+#include <data/batch/batch.hpp>
+#include <algorithm>
+#include <span>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 批次交错存储的矩阵列表：InterleavedBatch<TElem, DeviceTags::CPU>
+// 第b个矩阵的元素(i, j)存放在(i * colNum + j) * laneLen + b，即批次下标在最内层，各矩阵同一位置的元素（一组通道）连续存放
+// 矩阵很小而个数很多时，逐元素运算与小矩阵乘法沿批次方向计算，一个向量寄存器同时处理多个矩阵的同一位置（见elementwise.hpp与dot.hpp）
+// laneLen是batchNum按内存策略的RowAlignment填充后的长度，每组通道都从对齐的地址开始
+// view()得到矩阵间隔为1的BatchMatrixView，一般的列表运算也可以直接访问
+// 拷贝是浅拷贝，写操作与Batch相同，底层内存被共享时先脱离共享
+template<typename TElem>
+class InterleavedBatch<TElem, DeviceTags::CPU>
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type");
+public:
+    using Category = CategoryTags::BatchMatrix;
+    using ElementType = TElem;
+    using DeviceType = DeviceTags::CPU;
+public:
+    InterleavedBatch(std::size_t batchNum = 0, std::size_t row = 0, std::size_t col = 0)
+        : m_mem(row * col * paddedRowLen<ElementType, DeviceType>(batchNum), "InterleavedBatch")
+        , m_rowNum(row)
+        , m_colNum(col)
+        , m_batchNum(batchNum)
+        , m_laneLen(paddedRowLen<ElementType, DeviceType>(batchNum))
+    {
+    }
+
+    // 查询接口
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    std::size_t batchNum() const
+    {
+        return m_batchNum;
+    }
+    // 相邻两组通道起始位置的间隔
+    std::size_t laneLen() const
+    {
+        return m_laneLen;
+    }
+    bool availableForWrite() const
+    {
+        return m_mem.availableForWrite();
+    }
+    void setValue(std::size_t batchId, std::size_t row, std::size_t col, ElementType val)
+    {
+        assert(batchId < m_batchNum && row < m_rowNum && col < m_colNum);
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        m_mem.rawMemory()[(row * m_colNum + col) * m_laneLen + batchId] = val;
+    }
+    // 读取接口：返回一个临时矩阵，共享存储，仅用于访问
+    const auto operator[](std::size_t batchId) const
+    {
+        assert(batchId < m_batchNum);
+        return Matrix<ElementType, DeviceType>(ContinuousMemory<ElementType, DeviceType>(m_mem, m_mem.rawMemory() + batchId),
+                                               m_rowNum, m_colNum, m_colNum * m_laneLen, m_laneLen);
+    }
+
+    // 所有矩阵第(row, col)个元素组成的一组通道
+    std::span<const ElementType> lanes(std::size_t row, std::size_t col) const
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        return std::span<const ElementType>(m_mem.rawMemory() + (row * m_colNum + col) * m_laneLen, m_batchNum);
+    }
+    std::span<ElementType> mutableLanes(std::size_t row, std::size_t col)
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        return std::span<ElementType>(m_mem.rawMemory() + (row * m_colNum + col) * m_laneLen, m_batchNum);
+    }
+
+    // 批量访问视图，含义同Batch::view()与Batch::mutableView()
+    BatchMatrixView<const ElementType> view() const
+    {
+        return BatchMatrixView<const ElementType>(m_mem.rawMemory(), m_batchNum, m_rowNum, m_colNum,
+                                                  1, m_colNum * m_laneLen, m_laneLen);
+    }
+    BatchMatrixView<ElementType> mutableView()
+    {
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        return BatchMatrixView<ElementType>(m_mem.rawMemory(), m_batchNum, m_rowNum, m_colNum,
+                                            1, m_colNum * m_laneLen, m_laneLen);
+    }
+
+private:
+    void detach()
+    {
+        const std::size_t size = m_rowNum * m_colNum * m_laneLen;
+        ContinuousMemory<ElementType, DeviceType> mem(size, "InterleavedBatch");
+        std::copy(m_mem.rawMemory(), m_mem.rawMemory() + size, mem.rawMemory());
+        m_mem = std::move(mem);
+        CopyOnWrite::recordDetach<Category>(size * sizeof(ElementType));
+    }
+
+private:
+    ContinuousMemory<ElementType, DeviceType> m_mem;
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+    std::size_t m_batchNum;
+    std::size_t m_laneLen;
+};
+
+template<typename T>
+struct IsInterleavedBatch_ : std::false_type {};
+
+template<typename TElem, typename TDevice>
+struct IsInterleavedBatch_<InterleavedBatch<TElem, TDevice>> : std::true_type {};
+
+template<typename T>
+concept InterleavedBatchC = IsInterleavedBatch_<std::remove_cvref_t<T>>::value;
+
+// 按矩阵依次存储的矩阵列表转换为批次交错存储
+template<typename TElem>
+InterleavedBatch<TElem, DeviceTags::CPU> makeInterleaved(const Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix>& batch)
+{
+    InterleavedBatch<TElem, DeviceTags::CPU> res(batch.batchNum(), batch.rowNum(), batch.colNum());
+    const auto src = batch.view();
+    for (std::size_t i = 0; i < batch.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < batch.colNum(); ++j)
+        {
+            const auto dest = res.mutableLanes(i, j);
+            for (std::size_t b = 0; b < batch.batchNum(); ++b)
+            {
+                dest[b] = src(b, i, j);
+            }
+        }
+    }
+    return res;
+}
+
+// 批次交错存储的矩阵列表转换为按矩阵依次存储
+template<typename TElem>
+Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> makeDense(const InterleavedBatch<TElem, DeviceTags::CPU>& interleaved)
+{
+    Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> res(interleaved.batchNum(), interleaved.rowNum(), interleaved.colNum());
+    const auto dest = res.mutableView();
+    for (std::size_t i = 0; i < interleaved.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < interleaved.colNum(); ++j)
+        {
+            const auto src = interleaved.lanes(i, j);
+            for (std::size_t b = 0; b < src.size(); ++b)
+            {
+                dest(b, i, j) = src[b];
+            }
+        }
+    }
+    return res;
+}
+
+} // namespace MetaNN
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <data/allocator.hpp>
+#include <data/copy_on_write.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/matrix_view.hpp>
+#include <data/batch/batch.hpp>
+#include <algorithm>
+#include <span>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 变长矩阵列表：RaggedBatch<TElem, DeviceTags::CPU>，用于长度不同的序列
+// 各矩阵列数相同、行数不同，所有行依次存放在一块连续内存中（行长度按RowAlignment填充，含义同Matrix），不为较短的矩阵填充行
+// 第b个矩阵（一段）是第offsets[b]到offsets[b + 1]行，offsets共batchNum + 1项，在拷贝与逐元素运算的结果之间共享
+// rowNum()是最长一段的行数，即填充为Batch时的行数；rowNum(b)是第b段的行数
+// 逐元素运算在所有行组成的矩阵（packedView()）上进行，与矩阵相乘时所有行整体相乘，与矩阵列表相乘时逐段计算（见dot.hpp）
+// 拷贝是浅拷贝，写操作与Batch相同，底层内存被共享时先脱离共享
+template<typename TElem>
+class RaggedBatch<TElem, DeviceTags::CPU>
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type");
+public:
+    using Category = CategoryTags::BatchMatrix;
+    using ElementType = TElem;
+    using DeviceType = DeviceTags::CPU;
+public:
+    // rowNums依次是各段的行数
+    RaggedBatch(std::span<const std::size_t> rowNums = {}, std::size_t col = 0)
+        : RaggedBatch(makeOffsets(rowNums), rowNums.size(), col)
+    {
+    }
+    // 与segments分段相同（共享offsets）、列数为col的新列表
+    static RaggedBatch withSegmentsOf(const RaggedBatch& segments, std::size_t col)
+    {
+        return RaggedBatch(segments.m_offsets, segments.m_batchNum, col);
+    }
+
+    // 查询接口
+    std::size_t batchNum() const
+    {
+        return m_batchNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    // 最长一段的行数
+    std::size_t rowNum() const
+    {
+        return m_maxRowNum;
+    }
+    std::size_t rowNum(std::size_t batchId) const
+    {
+        assert(batchId < m_batchNum);
+        return rowOffset(batchId + 1) - rowOffset(batchId);
+    }
+    // 第batchId段第一行在所有行中的位置，rowOffset(batchNum())是总行数
+    std::size_t rowOffset(std::size_t batchId) const
+    {
+        assert(batchId <= m_batchNum);
+        return m_offsets.rawMemory()[batchId];
+    }
+    std::size_t totalRowNum() const
+    {
+        return rowOffset(m_batchNum);
+    }
+    std::span<const std::size_t> offsets() const
+    {
+        return std::span<const std::size_t>(m_offsets.rawMemory(), m_batchNum + 1);
+    }
+    // 分段是否与另一个列表相同
+    template<typename TOther>
+    bool sameSegments(const RaggedBatch<TOther, DeviceType>& other) const
+    {
+        return offsets().data() == other.offsets().data() || std::ranges::equal(offsets(), other.offsets());
+    }
+    bool availableForWrite() const
+    {
+        return m_mem.availableForWrite();
+    }
+
+    void setValue(std::size_t batchId, std::size_t row, std::size_t col, ElementType val)
+    {
+        assert(batchId < m_batchNum && row < rowNum(batchId) && col < m_colNum);
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        m_mem.rawMemory()[(rowOffset(batchId) + row) * m_rowLen + col] = val;
+    }
+    // 读取接口：返回一个临时矩阵，共享存储，仅用于访问
+    const auto operator[](std::size_t batchId) const
+    {
+        assert(batchId < m_batchNum);
+        auto pos = m_mem.rawMemory() + rowOffset(batchId) * m_rowLen;
+        return Matrix<ElementType, DeviceType>(ContinuousMemory<ElementType, DeviceType>(m_mem, pos),
+                                               rowNum(batchId), m_colNum, m_rowLen);
+    }
+
+    // 所有行依次排列组成的矩阵的视图
+    MatrixView<const ElementType> packedView() const
+    {
+        return MatrixView<const ElementType>(m_mem.rawMemory(), totalRowNum(), m_colNum, m_rowLen);
+    }
+    MatrixView<ElementType> mutablePackedView()
+    {
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        return MatrixView<ElementType>(m_mem.rawMemory(), totalRowNum(), m_colNum, m_rowLen);
+    }
+
+private:
+    RaggedBatch(ContinuousMemory<std::size_t, DeviceType> offsets, std::size_t batchNum, std::size_t col)
+        : m_mem(offsets.rawMemory()[batchNum] * paddedRowLen<ElementType, DeviceType>(col), "RaggedBatch")
+        , m_offsets(std::move(offsets))
+        , m_batchNum(batchNum)
+        , m_colNum(col)
+        , m_rowLen(paddedRowLen<ElementType, DeviceType>(col))
+        , m_maxRowNum(0)
+    {
+        for (std::size_t b = 0; b < m_batchNum; ++b)
+        {
+            m_maxRowNum = std::max(m_maxRowNum, rowNum(b));
+        }
+    }
+
+    static ContinuousMemory<std::size_t, DeviceType> makeOffsets(std::span<const std::size_t> rowNums)
+    {
+        ContinuousMemory<std::size_t, DeviceType> res(rowNums.size() + 1, "RaggedBatch");
+        std::size_t* pOffsets = res.rawMemory();
+        pOffsets[0] = 0;
+        for (std::size_t b = 0; b < rowNums.size(); ++b)
+        {
+            pOffsets[b + 1] = pOffsets[b] + rowNums[b];
+        }
+        return res;
+    }
+
+    void detach()
+    {
+        const std::size_t size = totalRowNum() * m_rowLen;
+        ContinuousMemory<ElementType, DeviceType> mem(size, "RaggedBatch");
+        std::copy(m_mem.rawMemory(), m_mem.rawMemory() + size, mem.rawMemory());
+        m_mem = std::move(mem);
+        CopyOnWrite::recordDetach<Category>(size * sizeof(ElementType));
+    }
+
+private:
+    ContinuousMemory<ElementType, DeviceType> m_mem;
+    ContinuousMemory<std::size_t, DeviceType> m_offsets;
+    std::size_t m_batchNum;
+    std::size_t m_colNum;
+    std::size_t m_rowLen;
+    std::size_t m_maxRowNum;
+};
+
+template<typename T>
+struct IsRaggedBatch_ : std::false_type {};
+
+template<typename TElem, typename TDevice>
+struct IsRaggedBatch_<RaggedBatch<TElem, TDevice>> : std::true_type {};
+
+template<typename T>
+concept RaggedBatchC = IsRaggedBatch_<std::remove_cvref_t<T>>::value;
+
+// 填充的矩阵列表转换为变长列表：第b段是padded[b]的前rowNums[b]行
+template<typename TElem>
+RaggedBatch<TElem, DeviceTags::CPU> makeRagged(const Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix>& padded,
+                                               std::span<const std::size_t> rowNums)
+{
+    assert(rowNums.size() == padded.batchNum());
+    RaggedBatch<TElem, DeviceTags::CPU> res(rowNums, padded.colNum());
+    const auto src = padded.view();
+    const auto dest = res.mutablePackedView();
+    for (std::size_t b = 0; b < rowNums.size(); ++b)
+    {
+        assert(rowNums[b] <= padded.rowNum());
+        for (std::size_t i = 0; i < rowNums[b]; ++i)
+        {
+            for (std::size_t j = 0; j < padded.colNum(); ++j)
+            {
+                dest(res.rowOffset(b) + i, j) = src(b, i, j);
+            }
+        }
+    }
+    return res;
+}
+
+// 变长列表填充为矩阵列表：每个矩阵有rowNum行（默认为最长一段的行数），多出的行填充为0
+template<typename TElem>
+Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> makePadded(const RaggedBatch<TElem, DeviceTags::CPU>& ragged, std::size_t rowNum)
+{
+    Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> res(ragged.batchNum(), rowNum, ragged.colNum());
+    const auto src = ragged.packedView();
+    const auto dest = res.mutableView();
+    for (std::size_t b = 0; b < ragged.batchNum(); ++b)
+    {
+        assert(ragged.rowNum(b) <= rowNum);
+        for (std::size_t i = 0; i < rowNum; ++i)
+        {
+            const auto row = dest[b].row(i);
+            if (i < ragged.rowNum(b))
+            {
+                std::copy_n(src.row(ragged.rowOffset(b) + i).data(), ragged.colNum(), row.data());
+            }
+            else
+            {
+                std::fill(row.begin(), row.end(), TElem{});
+            }
+        }
+    }
+    return res;
+}
+
+template<typename TElem>
+Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> makePadded(const RaggedBatch<TElem, DeviceTags::CPU>& ragged)
+{
+    return makePadded(ragged, ragged.rowNum());
+}
+
+} // namespace MetaNN
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace MetaNN
+{
+
+// 写时复制统计：Matrix与Batch在底层内存被共享时写入，会先复制出私有的一份（脱离共享），再写入
+// 脱离次数多说明流水线中存在不必要的共享，可以据此定位
+struct CopyOnWriteStatistics
+{
+    std::size_t matrixDetachCount = 0;      // Matrix脱离共享的次数
+    std::size_t batchScalarDetachCount = 0; // Batch<..., Scalar>脱离共享的次数
+    std::size_t batchMatrixDetachCount = 0; // Batch<..., Matrix>脱离共享的次数
+    std::size_t detachedBytes = 0;          // 脱离共享时复制的总字节数
+
+    std::size_t detachCount() const
+    {
+        return matrixDetachCount + batchScalarDetachCount + batchMatrixDetachCount;
+    }
+};
+
+class CopyOnWrite
+{
+public:
+    template<typename TCategory>
+    static void recordDetach(std::size_t bytes)
+    {
+        Counters& counters = instance();
+        if constexpr (std::is_same_v<TCategory, CategoryTags::Matrix>)
+        {
+            counters.matrixDetachCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if constexpr (std::is_same_v<TCategory, CategoryTags::BatchScalar>)
+        {
+            counters.batchScalarDetachCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            static_assert(std::is_same_v<TCategory, CategoryTags::BatchMatrix>, "Unsupported category");
+            counters.batchMatrixDetachCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        counters.detachedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static CopyOnWriteStatistics statistics()
+    {
+        Counters& counters = instance();
+        CopyOnWriteStatistics stats;
+        stats.matrixDetachCount = counters.matrixDetachCount.load(std::memory_order_relaxed);
+        stats.batchScalarDetachCount = counters.batchScalarDetachCount.load(std::memory_order_relaxed);
+        stats.batchMatrixDetachCount = counters.batchMatrixDetachCount.load(std::memory_order_relaxed);
+        stats.detachedBytes = counters.detachedBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    static void resetStatistics()
+    {
+        Counters& counters = instance();
+        counters.matrixDetachCount.store(0, std::memory_order_relaxed);
+        counters.batchScalarDetachCount.store(0, std::memory_order_relaxed);
+        counters.batchMatrixDetachCount.store(0, std::memory_order_relaxed);
+        counters.detachedBytes.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Counters
+    {
+        std::atomic<std::size_t> matrixDetachCount{0};
+        std::atomic<std::size_t> batchScalarDetachCount{0};
+        std::atomic<std::size_t> batchMatrixDetachCount{0};
+        std::atomic<std::size_t> detachedBytes{0};
+    };
+
+    static Counters& instance()
+    {
+        static Counters counters;
+        return counters;
+    }
+};
+
+} // namespace MetaNN
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace MetaNN
+{
+
+// 求值结果缓存：用于平凡矩阵、全零矩阵等不保存元素的数据，在第一次需要稠密形式时生成并保存，之后直接返回
+// 缓存状态在对象的拷贝之间共享：运算表达式中保存的是数据的拷贝，通过任意一个拷贝生成的结果对其他拷贝同样可用
+// 生成过程只执行一次，可以在多个线程中同时访问
+// 可变的数据（如Array）被修改后调用reset()丢弃结果，此后由该对象及其新的拷贝重新生成
+template<typename TData>
+class EvalCache
+{
+public:
+    EvalCache()
+        : m_state(std::make_shared<State>())
+    {
+    }
+
+    // 返回缓存的结果，尚未生成时调用build生成
+    template<typename TBuild>
+    const TData& get(TBuild&& build) const
+    {
+        std::call_once(m_state->flag, [&]() { m_state->data.emplace(build()); });
+        return *m_state->data;
+    }
+
+    bool cached() const
+    {
+        return m_state->data.has_value();
+    }
+
+    // 丢弃缓存：改用新的缓存状态，修改前得到的拷贝仍然保留原有的结果
+    void reset()
+    {
+        m_state = std::make_shared<State>();
+    }
+
+private:
+    struct State
+    {
+        std::once_flag flag;
+        std::optional<TData> data;
+    };
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace MetaNN
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/allocator.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <memory>
+#include <concepts>
+#include <type_traits>
+#include <cstddef>
+
+namespace MetaNN
+{
+
+// 在调用方已经持有的内存上零拷贝地构造数据，避免分配后再逐个setValue复制
+// 外部内存的生命周期有两种维护方式：
+//   keepAlive: 任意共享所有权句柄，最后一个使用该内存的数据对象销毁后释放
+//   deleter:   可调用对象，最后一个使用该内存的数据对象销毁后以数据指针调用
+// 元素类型为const时构造的数据是只读的，availableForWrite()始终为false，写入时先复制出私有副本
+
+template<typename TElem>
+ContinuousMemory<std::remove_const_t<TElem>, DeviceTags::CPU> externalMemory(TElem* data, std::shared_ptr<void> keepAlive)
+{
+    using ElementType = std::remove_const_t<TElem>;
+    return ContinuousMemory<ElementType, DeviceTags::CPU>(const_cast<ElementType*>(data), std::move(keepAlive),
+                                                          std::is_const_v<TElem>);
+}
+
+template<typename TElem, typename TDeleter>
+    requires std::invocable<TDeleter&, TElem*>
+ContinuousMemory<std::remove_const_t<TElem>, DeviceTags::CPU> externalMemory(TElem* data, TDeleter deleter)
+{
+    return externalMemory(data, std::shared_ptr<void>(static_cast<void*>(const_cast<std::remove_const_t<TElem>*>(data)),
+                                                      [deleter = std::move(deleter), data](void*) mutable {
+        deleter(data);
+    }));
+}
+
+// 矩阵：rowLen为相邻两行起始位置的间隔（元素数量），不小于col
+template<typename TElem, typename TOwner>
+Matrix<std::remove_const_t<TElem>, DeviceTags::CPU> externalMatrix(TElem* data, std::size_t row, std::size_t col,
+                                                                   std::size_t rowLen, TOwner&& owner)
+{
+    return Matrix<std::remove_const_t<TElem>, DeviceTags::CPU>(externalMemory(data, std::forward<TOwner>(owner)),
+                                                               row, col, rowLen);
+}
+
+template<typename TElem, typename TOwner>
+Batch<std::remove_const_t<TElem>, DeviceTags::CPU, CategoryTags::Scalar> externalBatchScalar(TElem* data, std::size_t length,
+                                                                                            TOwner&& owner)
+{
+    return Batch<std::remove_const_t<TElem>, DeviceTags::CPU, CategoryTags::Scalar>(
+        externalMemory(data, std::forward<TOwner>(owner)), length);
+}
+
+// 矩阵列表：rowLen为矩阵相邻两行的间隔，matrixSize为相邻两个矩阵起始位置的间隔（均为元素数量）
+template<typename TElem, typename TOwner>
+Batch<std::remove_const_t<TElem>, DeviceTags::CPU, CategoryTags::Matrix> externalBatchMatrix(TElem* data, std::size_t batchNum,
+                                                                                            std::size_t row, std::size_t col,
+                                                                                            std::size_t rowLen, std::size_t matrixSize,
+                                                                                            TOwner&& owner)
+{
+    return Batch<std::remove_const_t<TElem>, DeviceTags::CPU, CategoryTags::Matrix>(
+        externalMemory(data, std::forward<TOwner>(owner)), batchNum, row, col, rowLen, matrixSize);
+}
+
+} // namespace MetaNN
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <iostream>
+
+namespace MetaNN
+{
+
+// 16位浮点元素类型：只用于存储，减少权重与激活值占用的内存与带宽，运算时转换为float计算后再舍入回16位
+// Float16:  IEEE 754 binary16（1位符号，5位指数，10位尾数），精度较高但范围小（最大65504）
+// BFloat16: float的高16位（1位符号，8位指数，7位尾数），范围与float相同但精度低
+// 两者均可隐式转换为float，由float构造需要显式转换；同类型之间的四则运算与比较结果仍为该类型，与其他算术类型混合运算时按float计算
+// 舍入方式为就近舍入到偶数，NaN保持为NaN
+// 求和类运算（矩阵乘法、折叠、softmax及其导数）在float中累加，见numeric_policy.hpp
+
+namespace NsFloat16
+{
+
+// 参考 https://gist.github.com/rygorous/2156668
+inline std::uint16_t floatToHalf(float value)
+{
+    constexpr std::uint32_t f32Infinity = 255u << 23;
+    constexpr std::uint32_t f16Overflow = (127u + 16) << 23;       // 65536，不小于该值的结果为无穷
+    constexpr std::uint32_t denormMagic = ((127u - 15) + (23 - 10) + 1) << 23;
+
+    std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    std::uint16_t res;
+    if (bits >= f16Overflow)
+    {
+        // 无穷与NaN
+        res = bits > f32Infinity ? 0x7E00 : 0x7C00;
+    }
+    else if (bits < (113u << 23))
+    {
+        // 结果为非规格化数或0：借助浮点加法的就近舍入把尾数对齐到最低位
+        float aligned = std::bit_cast<float>(bits) + std::bit_cast<float>(denormMagic);
+        res = static_cast<std::uint16_t>(std::bit_cast<std::uint32_t>(aligned) - denormMagic);
+    }
+    else
+    {
+        const std::uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += ((15u - 127) << 23) + 0xFFF + mantissaOdd;
+        res = static_cast<std::uint16_t>(bits >> 13);
+    }
+    return static_cast<std::uint16_t>(res | (sign >> 16));
+}
+
+inline float halfToFloat(std::uint16_t value)
+{
+    constexpr std::uint32_t shiftedExponent = 0x7C00u << 13;
+    constexpr float magic = std::bit_cast<float>(113u << 23);
+
+    std::uint32_t bits = (value & 0x7FFFu) << 13;
+    const std::uint32_t exponent = bits & shiftedExponent;
+    bits += (127u - 15) << 23;
+    if (exponent == shiftedExponent)
+    {
+        // 无穷与NaN
+        bits += (128u - 16) << 23;
+    }
+    else if (exponent == 0)
+    {
+        // 0与非规格化数
+        bits += 1u << 23;
+        bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) - magic);
+    }
+    return std::bit_cast<float>(bits | (static_cast<std::uint32_t>(value & 0x8000u) << 16));
+}
+
+inline std::uint16_t floatToBFloat(float value)
+{
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+    {
+        // NaN：截断可能丢失尾数中的全部1，强制为静默NaN
+        return static_cast<std::uint16_t>((bits >> 16) | 0x0040);
+    }
+    const std::uint32_t roundingBias = 0x7FFF + ((bits >> 16) & 1);
+    return static_cast<std::uint16_t>((bits + roundingBias) >> 16);
+}
+
+inline float bfloatToFloat(std::uint16_t value)
+{
+    return std::bit_cast<float>(static_cast<std::uint32_t>(value) << 16);
+}
+
+// 两种类型共用的接口，FromFloat与ToFloat提供与float之间的转换
+template<typename TDerived, std::uint16_t (*FromFloat)(float), float (*ToFloat)(std::uint16_t)>
+class Float16Base
+{
+public:
+    Float16Base() = default;
+    explicit Float16Base(float value)
+        : m_bits(FromFloat(value))
+    {
+    }
+
+    operator float() const
+    {
+        return ToFloat(m_bits);
+    }
+
+    std::uint16_t bits() const
+    {
+        return m_bits;
+    }
+    static TDerived fromBits(std::uint16_t bits)
+    {
+        TDerived res;
+        res.m_bits = bits;
+        return res;
+    }
+
+    friend TDerived operator+(TDerived lhs, TDerived rhs)
+    {
+        return TDerived(float(lhs) + float(rhs));
+    }
+    friend TDerived operator-(TDerived lhs, TDerived rhs)
+    {
+        return TDerived(float(lhs) - float(rhs));
+    }
+    friend TDerived operator*(TDerived lhs, TDerived rhs)
+    {
+        return TDerived(float(lhs) * float(rhs));
+    }
+    friend TDerived operator/(TDerived lhs, TDerived rhs)
+    {
+        return TDerived(float(lhs) / float(rhs));
+    }
+    friend TDerived operator-(TDerived val)
+    {
+        return fromBits(static_cast<std::uint16_t>(val.m_bits ^ 0x8000));
+    }
+    friend TDerived& operator+=(TDerived& lhs, TDerived rhs)
+    {
+        return lhs = lhs + rhs;
+    }
+    friend TDerived& operator-=(TDerived& lhs, TDerived rhs)
+    {
+        return lhs = lhs - rhs;
+    }
+    friend TDerived& operator*=(TDerived& lhs, TDerived rhs)
+    {
+        return lhs = lhs * rhs;
+    }
+    friend TDerived& operator/=(TDerived& lhs, TDerived rhs)
+    {
+        return lhs = lhs / rhs;
+    }
+
+    // 按数值比较：+0与-0相等，NaN与任何值都不相等
+    friend bool operator==(TDerived lhs, TDerived rhs)
+    {
+        return float(lhs) == float(rhs);
+    }
+    friend bool operator<(TDerived lhs, TDerived rhs)
+    {
+        return float(lhs) < float(rhs);
+    }
+    friend bool operator>(TDerived lhs, TDerived rhs)
+    {
+        return float(lhs) > float(rhs);
+    }
+    friend bool operator<=(TDerived lhs, TDerived rhs)
+    {
+        return float(lhs) <= float(rhs);
+    }
+    friend bool operator>=(TDerived lhs, TDerived rhs)
+    {
+        return float(lhs) >= float(rhs);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, TDerived val)
+    {
+        return os << float(val);
+    }
+
+private:
+    std::uint16_t m_bits = 0;
+};
+
+} // namespace NsFloat16
+
+class Float16 : public NsFloat16::Float16Base<Float16, NsFloat16::floatToHalf, NsFloat16::halfToFloat>
+{
+public:
+    using Float16Base::Float16Base;
+};
+
+class BFloat16 : public NsFloat16::Float16Base<BFloat16, NsFloat16::floatToBFloat, NsFloat16::bfloatToFloat>
+{
+public:
+    using Float16Base::Float16Base;
+};
+
+static_assert(sizeof(Float16) == 2 && sizeof(BFloat16) == 2);
+
+} // namespace MetaNN
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/memory_block.hpp>
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <sys/mman.h>
+
+namespace MetaNN
+{
+
+// 大页分配的统计信息，字节数均按实际映射的长度（大页大小的整数倍）计算
+struct HugePageStatistics
+{
+    std::size_t allocateCount = 0;          // 分配次数
+    std::size_t hugePageAllocateCount = 0;  // 使用了大页（显式或透明）的分配次数
+    std::size_t explicitBytes = 0;          // 累计由显式大页（MAP_HUGETLB）提供的字节数
+    std::size_t transparentBytes = 0;       // 累计通过madvise请求透明大页的字节数
+    std::size_t fallbackBytes = 0;          // 超过阈值但未能使用大页、退回普通页的字节数
+    std::size_t liveHugePageBytes = 0;      // 当前仍在使用的大页字节数
+
+    std::size_t hugePageBytes() const
+    {
+        return explicitBytes + transparentBytes;
+    }
+};
+
+template<typename TDevice>
+class HugePageAllocator;
+
+// CPU大页分配器：不小于阈值的内存块直接通过mmap映射，按大页大小对齐并请求大页，减少大矩阵访问时的TLB缺失
+// 显式方式先尝试MAP_HUGETLB（需要系统预留大页），失败时退回透明大页
+// 透明方式通过madvise(MADV_HUGEPAGE)请求透明大页，内核不支持时退回普通页
+// 小于阈值的内存块与普通分配器相同，直接从堆上申请
+// 透明大页由内核在缺页时决定是否真正使用，residentTransparentBytes()给出进程当前实际由透明大页提供的字节数
+template<>
+class HugePageAllocator<DeviceTags::CPU>
+{
+public:
+    // x86-64与AArch64（4KB基础页）上默认的大页大小
+    static constexpr std::size_t HugePageSize = std::size_t(2) << 20;
+
+    static RawMemory allocate(std::size_t bytes, std::size_t alignment, std::size_t threshold, bool explicitPages)
+    {
+        Stats& stats = instance();
+        stats.allocateCount.fetch_add(1, std::memory_order_relaxed);
+        if (bytes < threshold || bytes == 0)
+        {
+            void* ptr = ::operator new(bytes, std::align_val_t{alignment});
+            return RawMemory{ptr, bytes, alignment, context(Backing::Heap), &deallocate};
+        }
+
+        std::size_t length = (bytes + HugePageSize - 1) / HugePageSize * HugePageSize;
+        if (explicitPages)
+        {
+            void* ptr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED)
+            {
+                stats.explicitBytes.fetch_add(length, std::memory_order_relaxed);
+                return hugePageMemory(ptr, length, Backing::Explicit);
+            }
+        }
+
+        void* ptr = mapAligned(length);
+        if (::madvise(ptr, length, MADV_HUGEPAGE) == 0)
+        {
+            stats.transparentBytes.fetch_add(length, std::memory_order_relaxed);
+            return hugePageMemory(ptr, length, Backing::Transparent);
+        }
+        stats.fallbackBytes.fetch_add(length, std::memory_order_relaxed);
+        return RawMemory{ptr, length, HugePageSize, context(Backing::Mapped), &deallocate};
+    }
+
+    static HugePageStatistics statistics()
+    {
+        Stats& stats = instance();
+        HugePageStatistics res;
+        res.allocateCount = stats.allocateCount.load(std::memory_order_relaxed);
+        res.hugePageAllocateCount = stats.hugePageAllocateCount.load(std::memory_order_relaxed);
+        res.explicitBytes = stats.explicitBytes.load(std::memory_order_relaxed);
+        res.transparentBytes = stats.transparentBytes.load(std::memory_order_relaxed);
+        res.fallbackBytes = stats.fallbackBytes.load(std::memory_order_relaxed);
+        res.liveHugePageBytes = stats.liveHugePageBytes.load(std::memory_order_relaxed);
+        return res;
+    }
+
+    // 清空累计计数，不影响当前仍在使用的字节数
+    static void resetStatistics()
+    {
+        Stats& stats = instance();
+        stats.allocateCount.store(0, std::memory_order_relaxed);
+        stats.hugePageAllocateCount.store(0, std::memory_order_relaxed);
+        stats.explicitBytes.store(0, std::memory_order_relaxed);
+        stats.transparentBytes.store(0, std::memory_order_relaxed);
+        stats.fallbackBytes.store(0, std::memory_order_relaxed);
+    }
+
+    // 进程当前实际由透明大页提供的匿名内存字节数（读取/proc/self/smaps_rollup），无法获取时返回0
+    static std::size_t residentTransparentBytes()
+    {
+        std::ifstream ifs("/proc/self/smaps_rollup");
+        std::string key;
+        while (ifs >> key)
+        {
+            if (key == "AnonHugePages:")
+            {
+                std::size_t kb = 0;
+                ifs >> kb;
+                return kb * 1024;
+            }
+            ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        return 0;
+    }
+
+private:
+    // 内存块的来源，记录在RawMemory::context中
+    enum class Backing : std::uintptr_t
+    {
+        Heap,
+        Mapped,
+        Explicit,
+        Transparent
+    };
+
+    struct Stats
+    {
+        std::atomic<std::size_t> allocateCount{0};
+        std::atomic<std::size_t> hugePageAllocateCount{0};
+        std::atomic<std::size_t> explicitBytes{0};
+        std::atomic<std::size_t> transparentBytes{0};
+        std::atomic<std::size_t> fallbackBytes{0};
+        std::atomic<std::size_t> liveHugePageBytes{0};
+    };
+
+    static Stats& instance()
+    {
+        static Stats stats;
+        return stats;
+    }
+
+    static void* context(Backing backing)
+    {
+        return reinterpret_cast<void*>(static_cast<std::uintptr_t>(backing));
+    }
+
+    static RawMemory hugePageMemory(void* ptr, std::size_t length, Backing backing)
+    {
+        Stats& stats = instance();
+        stats.hugePageAllocateCount.fetch_add(1, std::memory_order_relaxed);
+        stats.liveHugePageBytes.fetch_add(length, std::memory_order_relaxed);
+        return RawMemory{ptr, length, HugePageSize, context(backing), &deallocate};
+    }
+
+    // 映射length字节的匿名内存，起始地址按大页大小对齐：多映射一个大页，再解除首尾多余的部分
+    static void* mapAligned(std::size_t length)
+    {
+        std::size_t mapped = length + HugePageSize;
+        void* ptr = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(ptr);
+        std::uintptr_t aligned = (begin + HugePageSize - 1) / HugePageSize * HugePageSize;
+        if (aligned != begin)
+        {
+            ::munmap(ptr, aligned - begin);
+        }
+        std::size_t tail = begin + mapped - (aligned + length);
+        if (tail != 0)
+        {
+            ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+        }
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    static void deallocate(const RawMemory& raw)
+    {
+        Backing backing = static_cast<Backing>(reinterpret_cast<std::uintptr_t>(raw.context));
+        if (backing == Backing::Heap)
+        {
+            ::operator delete(raw.ptr, std::align_val_t{raw.alignment});
+            return;
+        }
+        if (backing != Backing::Mapped)
+        {
+            instance().liveHugePageBytes.fetch_sub(raw.size, std::memory_order_relaxed);
+        }
+        ::munmap(raw.ptr, raw.size);
+    }
+};
+
+// 按内存策略固定阈值与大页方式的大页分配器，供AllocatorOf使用
+template<typename TDevice, std::size_t Threshold, bool ExplicitPages>
+struct HugePagePolicyAllocator
+{
+    static RawMemory allocate(std::size_t bytes, std::size_t alignment)
+    {
+        return HugePageAllocator<TDevice>::allocate(bytes, alignment, Threshold, ExplicitPages);
+    }
+};
+
+} // namespace MetaNN
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/allocator.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace MetaNN
+{
+
+// 文件映射方式
+// ReadOnly: 只读映射，基于其构造的数据availableForWrite()始终为false，写入时先复制到新分配的内存中
+// Private: 私有映射，页面写时复制，写入只影响本进程，不会写回文件
+//          同一映射上的数据共享映射区域：映射对象或者其他数据仍在使用映射时不能直接写入，第一次写入时先复制出私有副本；
+//          只有映射对象已经销毁、且没有其他数据使用该映射时才在映射的页面上原地写入
+enum class MapMode
+{
+    ReadOnly,
+    Private
+};
+
+// 将文件映射到内存，可以在映射的内存上零拷贝地构造Matrix与Batch，用于载入数据集或者训练好的参数
+// 映射区域的生命周期由引用计数维护：最后一个使用映射内存的数据对象销毁后才解除映射
+// 目前只支持POSIX系统
+class MappedFile
+{
+    struct Mapping
+    {
+        void* addr = nullptr;
+        std::size_t size = 0;
+
+        ~Mapping()
+        {
+            if (addr)
+            {
+                ::munmap(addr, size);
+            }
+        }
+    };
+
+public:
+    MappedFile(const std::string& path, MapMode mode = MapMode::ReadOnly)
+        : m_mode(mode)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "Cannot open file: " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "Cannot stat file: " + path);
+        }
+
+        auto mapping = std::make_shared<Mapping>();
+        mapping->size = static_cast<std::size_t>(st.st_size);
+        if (mapping->size != 0)
+        {
+            int prot = (mode == MapMode::ReadOnly) ? PROT_READ : (PROT_READ | PROT_WRITE);
+            void* addr = ::mmap(nullptr, mapping->size, prot, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+            {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "Cannot map file: " + path);
+            }
+            mapping->addr = addr;
+        }
+        // 映射建立后文件描述符不再需要
+        ::close(fd);
+        m_mapping = std::move(mapping);
+    }
+
+    std::size_t size() const
+    {
+        return m_mapping->size;
+    }
+    const void* data() const
+    {
+        return m_mapping->addr;
+    }
+    MapMode mode() const
+    {
+        return m_mode;
+    }
+
+    // 获取从offset字节开始、包含count个元素的连续内存，与映射共享存储
+    template<typename TElem>
+    ContinuousMemory<TElem, DeviceTags::CPU> memory(std::size_t offset, std::size_t count) const
+    {
+        static_assert(std::is_trivially_copyable_v<TElem>, "Mapped element must be trivially copyable");
+        if (offset > size() || count > (size() - offset) / sizeof(TElem))
+        {
+            throw std::out_of_range("Mapped region exceeds file size");
+        }
+        std::byte* p = static_cast<std::byte*>(m_mapping->addr) + offset;
+        if (reinterpret_cast<std::uintptr_t>(p) % alignof(TElem) != 0)
+        {
+            throw std::invalid_argument("Mapped region is not aligned for element type");
+        }
+        return ContinuousMemory<TElem, DeviceTags::CPU>(reinterpret_cast<TElem*>(p), m_mapping,
+                                                        m_mode == MapMode::ReadOnly, true);
+    }
+
+private:
+    std::shared_ptr<Mapping> m_mapping;
+    MapMode m_mode;
+};
+
+// 在映射的文件上构造数据，offset为数据在文件中的字节偏移，数据按行紧密排列
+template<typename TElem>
+Matrix<TElem, DeviceTags::CPU> mapMatrix(const MappedFile& file, std::size_t offset,
+                                         std::size_t row, std::size_t col)
+{
+    return Matrix<TElem, DeviceTags::CPU>(file.memory<TElem>(offset, row * col), row, col, col);
+}
+
+template<typename TElem>
+Batch<TElem, DeviceTags::CPU, CategoryTags::Scalar> mapBatchScalar(const MappedFile& file, std::size_t offset,
+                                                                   std::size_t length)
+{
+    return Batch<TElem, DeviceTags::CPU, CategoryTags::Scalar>(file.memory<TElem>(offset, length), length);
+}
+
+template<typename TElem>
+Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> mapBatchMatrix(const MappedFile& file, std::size_t offset,
+                                                                   std::size_t batchNum, std::size_t row, std::size_t col)
+{
+    return Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix>(file.memory<TElem>(offset, batchNum * row * col),
+                                                               batchNum, row, col);
+}
+
+} // namespace MetaNN
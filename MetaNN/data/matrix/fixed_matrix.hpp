@@ -0,0 +1,120 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <data/matrix/matrix_view.hpp>
+#include <facility/unroll.hpp>
+#include <array>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 编译期确定形状的矩阵：Matrix<TElem, DeviceTags::CPU, Rows, Cols>
+// 元素直接保存在对象内部，不需要堆分配与引用计数，适用于门控参数（如4*4）、偏置行向量等形状固定的小矩阵
+// 具有值语义：拷贝即复制全部元素，因此始终可写，也不提供共享存储的子矩阵
+// 元素默认初始化为0
+// 运算的求值对编译期形状的操作数使用完全展开的实现，结果同样是编译期形状的矩阵
+template<typename TElem, std::size_t Rows, std::size_t Cols>
+    requires (Rows != DynamicExtent && Cols != DynamicExtent)
+class Matrix<TElem, DeviceTags::CPU, Rows, Cols>
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type");
+public:
+    using Category = CategoryTags::Matrix;
+    using ElementType = TElem;
+    using DeviceType = DeviceTags::CPU;
+
+    static constexpr std::size_t RowNum = Rows;
+    static constexpr std::size_t ColNum = Cols;
+    static constexpr std::size_t Size = Rows * Cols;
+public:
+    Matrix()
+        : m_data{}
+    {
+    }
+    // 为了能够与动态形状的矩阵在泛型代码中统一构造，接受行列数，但必须与编译期形状一致
+    Matrix(std::size_t row, std::size_t col)
+        : m_data{}
+    {
+        assert(row == Rows && col == Cols);
+        (void)row;
+        (void)col;
+    }
+
+    static constexpr std::size_t rowNum()
+    {
+        return Rows;
+    }
+    static constexpr std::size_t colNum()
+    {
+        return Cols;
+    }
+    void setValue(std::size_t row, std::size_t col, ElementType val)
+    {
+        assert(row < Rows && col < Cols);
+        m_data[row * Cols + col] = val;
+    }
+    const auto operator()(std::size_t row, std::size_t col) const
+    {
+        assert(row < Rows && col < Cols);
+        return m_data[row * Cols + col];
+    }
+    constexpr bool availableForWrite() const
+    {
+        return true;
+    }
+
+    // 按行紧密排列的全部元素，供展开的计算核心直接访问
+    const std::array<ElementType, Size>& elements() const
+    {
+        return m_data;
+    }
+    std::array<ElementType, Size>& mutableElements()
+    {
+        return m_data;
+    }
+
+    MatrixView<const ElementType> view() const
+    {
+        return MatrixView<const ElementType>(m_data.data(), Rows, Cols, Cols);
+    }
+    MatrixView<ElementType> mutableView()
+    {
+        return MatrixView<ElementType>(m_data.data(), Rows, Cols, Cols);
+    }
+
+    // 转置：复制为新的编译期形状矩阵
+    Matrix<ElementType, DeviceType, Cols, Rows> transpose() const
+    {
+        Matrix<ElementType, DeviceType, Cols, Rows> res;
+        auto& dest = res.mutableElements();
+        unrollFor<Rows>([&](auto i) {
+            unrollFor<Cols>([&](auto j) {
+                dest[j * Rows + i] = m_data[i * Cols + j];
+            });
+        });
+        return res;
+    }
+
+private:
+    std::array<ElementType, Size> m_data;
+};
+
+template<typename TElem, std::size_t Rows, std::size_t Cols>
+using FixedMatrix = Matrix<TElem, DeviceTags::CPU, Rows, Cols>;
+
+// 编译期形状矩阵的判断
+template<typename T>
+struct IsFixedMatrix_ : std::false_type {};
+
+template<typename TElem, typename TDevice, std::size_t Rows, std::size_t Cols>
+    requires (Rows != DynamicExtent && Cols != DynamicExtent)
+struct IsFixedMatrix_<Matrix<TElem, TDevice, Rows, Cols>> : std::true_type {};
+
+template<typename T>
+concept FixedMatrixC = IsFixedMatrix_<std::remove_cvref_t<T>>::value;
+
+} // namespace MetaNN
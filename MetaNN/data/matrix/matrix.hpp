@@ -1,15 +1,21 @@
 #pragma once
 
 #include <data/tags.hpp>
+#include <data/traits.hpp>
 #include <data/allocator.hpp>
 #include <data/lower_access.hpp>
+#include <data/copy_on_write.hpp>
+#include <data/matrix/matrix_view.hpp>
 #include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
 #include <cassert>
 
 namespace MetaNN
 {
 
-template<typename TElem, typename TDevice = DeviceTags::CPU>
+template<typename TElem, typename TDevice, std::size_t Rows, std::size_t Cols>
 class Matrix;
 
 // 提供底层访问接口
@@ -31,13 +37,27 @@ public:
     using ElementType = TElem;
     using DeviceType = DeviceTags::CPU;
 public:
+    // 行长度按内存策略的RowAlignment填充（见memory_policy.hpp），默认不填充
     Matrix(std::size_t row = 0, std::size_t col = 0)
-        : m_mem(row * col)
+        : m_mem(row * paddedRowLen<ElementType, DeviceType>(col), "Matrix")
         , m_rowNum(row)
         , m_colNum(col)
-        , m_rowLen(col)
+        , m_rowLen(paddedRowLen<ElementType, DeviceType>(col))
+        , m_colStride(1)
     {
     }
+    // 在给定的内存上构造矩阵，共享存储，rowLen是相邻两行起始位置间隔的元素数量，colStride是同一行相邻两个元素间隔的元素数量
+    // 也用于构造子矩阵、转置视图，以及由外部内存（比如映射的文件）构造矩阵
+    Matrix(ContinuousMemory<ElementType, DeviceType> mem, std::size_t row, std::size_t col, std::size_t rowLen,
+        std::size_t colStride = 1)
+        : m_mem(std::move(mem))
+        , m_rowNum(row)
+        , m_colNum(col)
+        , m_rowLen(rowLen)
+        , m_colStride(colStride)
+    {
+        assert(colStride != 1 || rowLen >= col);
+    }
 
     // 访问接口
     std::size_t rowNum() const
@@ -48,22 +68,25 @@ public:
     {
         return m_colNum;
     }
-    // 写操作，需要可写才能调用
+    // 写操作：写时复制，底层内存被共享时先脱离共享，之后的写操作都在私有副本上进行
     void setValue(std::size_t row, std::size_t col, ElementType val)
     {
-        assert(availableForWrite());
         assert(row < m_rowNum && col < m_colNum);
-        m_mem.rawMemory()[row * m_rowLen + col] = val;
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        m_mem.rawMemory()[row * m_rowLen + col * m_colStride] = val;
     }
     // 读操作，返回副本而非引用
     const auto operator()(std::size_t row, std::size_t col) const
     {
         assert(row < m_rowNum && col < m_colNum);
-        return m_mem.rawMemory()[row * m_rowLen + col];
+        return m_mem.rawMemory()[row * m_rowLen + col * m_colStride];
     }
     bool availableForWrite() const
     {
-        return m_mem.useCount() == 1;
+        return m_mem.availableForWrite();
     }
 
     // 子矩阵接口，浅拷贝，共享存储空间，区间前闭后开
@@ -71,35 +94,81 @@ public:
     {
         assert(rowBegin < m_rowNum && colBegin < m_colNum);
         assert(rowEnd <= m_rowNum && colEnd <= m_colNum);
-        TElem* pos = m_mem.rawMemory() + rowBegin * m_rowLen + colBegin;
-        return Matrix(m_mem.sharedPtr(), pos, rowEnd - rowBegin, colEnd - colBegin, m_rowLen);
+        TElem* pos = m_mem.rawMemory() + rowBegin * m_rowLen + colBegin * m_colStride;
+        return Matrix(ContinuousMemory<ElementType, DeviceType>(m_mem, pos), rowEnd - rowBegin, colEnd - colBegin, m_rowLen, m_colStride);
+    }
+
+    // 批量访问视图：只读视图直接访问底层内存；可写视图与setValue相同，底层内存被共享时先脱离共享
+    MatrixView<const ElementType> view() const
+    {
+        return MatrixView<const ElementType>(m_mem.rawMemory(), m_rowNum, m_colNum, m_rowLen, m_colStride);
+    }
+    MatrixView<ElementType> mutableView()
+    {
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        return MatrixView<ElementType>(m_mem.rawMemory(), m_rowNum, m_colNum, m_rowLen, m_colStride);
+    }
+
+    // 转置视图，浅拷贝，共享存储空间，只交换行列数与行列间隔，不复制数据
+    // 结果只有一行（如N×1矩阵的转置）时行长度不起作用，取不小于列数的值，使行内连续的单行矩阵满足构造条件
+    Matrix transpose() const
+    {
+        const std::size_t rowLen = (m_colNum == 1) ? std::max(m_colStride, m_rowNum) : m_colStride;
+        return Matrix(m_mem, m_colNum, m_rowNum, rowLen, m_rowLen);
     }
 
     // 求值接口: todo
 
 private:
-    // 为构造子矩阵准备
-    Matrix(std::shared_ptr<ElementType> spMem, ElementType* pMemStart,
-        std::size_t row, std::size_t col, std::size_t rowLen)
-        : m_mem(spMem, pMemStart)
-        , m_rowNum(row)
-        , m_colNum(col)
-        , m_rowLen(rowLen)
+    // 复制出当前矩阵可见部分的私有副本，不影响共享同一内存的其他数据，副本的行长度与新构造的矩阵相同
+    void detach()
     {
+        const std::size_t rowLen = paddedRowLen<ElementType, DeviceType>(m_colNum);
+        ContinuousMemory<ElementType, DeviceType> mem(m_rowNum * rowLen, "Matrix");
+        const ElementType* pSrc = m_mem.rawMemory();
+        ElementType* pDest = mem.rawMemory();
+        for (std::size_t i = 0; i < m_rowNum; ++i)
+        {
+            if (m_colStride == 1)
+            {
+                std::copy(pSrc, pSrc + m_colNum, pDest);
+            }
+            else
+            {
+                for (std::size_t j = 0; j < m_colNum; ++j)
+                {
+                    pDest[j] = pSrc[j * m_colStride];
+                }
+            }
+            pSrc += m_rowLen;
+            pDest += rowLen;
+        }
+        m_mem = std::move(mem);
+        m_rowLen = rowLen;
+        m_colStride = 1;
+        CopyOnWrite::recordDetach<Category>(m_rowNum * rowLen * sizeof(ElementType));
     }
 private:
     ContinuousMemory<ElementType, DeviceType> m_mem;
     std::size_t m_rowNum;
     std::size_t m_colNum;
     std::size_t m_rowLen;
+    std::size_t m_colStride;
 };
 
 // 底层访问
 template<typename TElem>
 struct LowerAccessImpl<Matrix<TElem, DeviceTags::CPU>>
 {
+    // 底层内存块起始地址的对齐字节数，编译期常量，可以据此静态选择对齐的向量化实现
+    // 子矩阵的rawMemory()可能指向内存块中间，此时需要通过isAligned()在运行期确认
+    static constexpr std::size_t Alignment = MemoryAlignment<TElem, DeviceTags::CPU>;
+
     LowerAccessImpl(Matrix<TElem, DeviceTags::CPU> p)
-        : m_matrix(p) {}
+        : m_matrix(std::move(p)) {}
     
     // 使用这个接口提供的指针进行写操作具有一定安全性隐患，因为不会检查共享数量
     // 所以这个只应该提供给库作者使用，提供性能更高的操作，相当于一个后门，使用时应当非常注意
@@ -113,10 +182,21 @@ struct LowerAccessImpl<Matrix<TElem, DeviceTags::CPU>>
         return m_matrix.m_mem.rawMemory();
     }
 
+    // 行间隔：相邻两行起始位置间隔的元素数量
     std::size_t rowLen() const
     {
         return m_matrix.m_rowLen;
     }
+    // 列间隔：同一行相邻两个元素间隔的元素数量，通常为1，转置视图中为原矩阵的行间隔
+    std::size_t colStride() const
+    {
+        return m_matrix.m_colStride;
+    }
+
+    bool isAligned() const
+    {
+        return reinterpret_cast<std::uintptr_t>(rawMemory()) % Alignment == 0;
+    }
 
 private:
     Matrix<TElem, DeviceTags::CPU> m_matrix;
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <span>
+#include <iterator>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 矩阵的批量访问视图，类似于std::mdspan：保存数据指针、行列数与行列间隔，不持有内存
+// 视图只在创建它的数据对象存活且没有被写入（写入可能导致写时复制、更换底层内存）期间有效
+// 列连续（colStride() == 1）时可以按行取得std::span，内层循环是连续内存上的简单循环，便于编译器向量化
+template<typename TElem>
+class MatrixView
+{
+public:
+    using ElementType = TElem;
+
+    // 行迭代器：依次得到每一行的std::span，只能用于列连续的视图
+    class RowIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::span<TElem>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::span<TElem>;
+
+        RowIterator() = default;
+        RowIterator(TElem* p, std::size_t colNum, std::size_t rowStride)
+            : m_p(p), m_colNum(colNum), m_rowStride(rowStride) {}
+
+        std::span<TElem> operator*() const
+        {
+            return std::span<TElem>(m_p, m_colNum);
+        }
+        RowIterator& operator++()
+        {
+            m_p += m_rowStride;
+            return *this;
+        }
+        RowIterator operator++(int)
+        {
+            RowIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        bool operator==(const RowIterator& rhs) const
+        {
+            return m_p == rhs.m_p;
+        }
+
+    private:
+        TElem* m_p = nullptr;
+        std::size_t m_colNum = 0;
+        std::size_t m_rowStride = 0;
+    };
+
+public:
+    MatrixView(TElem* data, std::size_t rowNum, std::size_t colNum, std::size_t rowStride, std::size_t colStride = 1)
+        : m_data(data)
+        , m_rowNum(rowNum)
+        , m_colNum(colNum)
+        , m_rowStride(rowStride)
+        , m_colStride(colStride)
+    {
+    }
+
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    std::size_t rowStride() const
+    {
+        return m_rowStride;
+    }
+    std::size_t colStride() const
+    {
+        return m_colStride;
+    }
+    TElem* data() const
+    {
+        return m_data;
+    }
+    // 同一行的元素是否连续存放
+    bool isRowContiguous() const
+    {
+        return m_colStride == 1;
+    }
+    // 所有元素是否紧密连续存放，此时可以作为一维数组整体访问
+    bool isContiguous() const
+    {
+        return m_colStride == 1 && (m_rowStride == m_colNum || m_rowNum <= 1);
+    }
+
+    TElem& operator()(std::size_t row, std::size_t col) const
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        return m_data[row * m_rowStride + col * m_colStride];
+    }
+
+    std::span<TElem> row(std::size_t rowId) const
+    {
+        assert(rowId < m_rowNum && isRowContiguous());
+        return std::span<TElem>(m_data + rowId * m_rowStride, m_colNum);
+    }
+    // 紧密连续存放时的全部元素
+    std::span<TElem> elements() const
+    {
+        assert(isContiguous());
+        return std::span<TElem>(m_data, m_rowNum * m_colNum);
+    }
+
+    RowIterator begin() const
+    {
+        assert(isRowContiguous());
+        return RowIterator(m_data, m_colNum, m_rowStride);
+    }
+    RowIterator end() const
+    {
+        return RowIterator(m_data + m_rowNum * m_rowStride, m_colNum, m_rowStride);
+    }
+
+    MatrixView subView(std::size_t rowBegin, std::size_t rowEnd, std::size_t colBegin, std::size_t colEnd) const
+    {
+        assert(rowBegin <= rowEnd && rowEnd <= m_rowNum && colBegin <= colEnd && colEnd <= m_colNum);
+        return MatrixView(m_data + rowBegin * m_rowStride + colBegin * m_colStride,
+                          rowEnd - rowBegin, colEnd - colBegin, m_rowStride, m_colStride);
+    }
+    MatrixView transpose() const
+    {
+        return MatrixView(m_data, m_colNum, m_rowNum, m_colStride, m_rowStride);
+    }
+
+private:
+    TElem* m_data;
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+    std::size_t m_rowStride;
+    std::size_t m_colStride;
+};
+
+// 所有元素都相同的矩阵（平凡矩阵、全零矩阵）的视图：只保存元素值与行列数，不对应任何存储
+// 接口与只读的MatrixView一致，row(i)返回的对象可以像行指针一样按下标访问，逐元素运算可以把它与行连续的视图一同处理
+template<typename TElem>
+class BroadcastView
+{
+public:
+    using ElementType = TElem;
+
+    // 广播的一行：任意下标都返回同一个值
+    class Row
+    {
+    public:
+        explicit Row(TElem value)
+            : m_value(value) {}
+
+        TElem operator[](std::size_t) const
+        {
+            return m_value;
+        }
+
+    private:
+        TElem m_value;
+    };
+
+public:
+    BroadcastView(TElem value, std::size_t rowNum, std::size_t colNum)
+        : m_value(value)
+        , m_rowNum(rowNum)
+        , m_colNum(colNum)
+    {
+    }
+
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    TElem value() const
+    {
+        return m_value;
+    }
+    bool isRowContiguous() const
+    {
+        return true;
+    }
+
+    TElem operator()([[maybe_unused]] std::size_t row, [[maybe_unused]] std::size_t col) const
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        return m_value;
+    }
+    Row row([[maybe_unused]] std::size_t rowId) const
+    {
+        assert(rowId < m_rowNum);
+        return Row(m_value);
+    }
+
+private:
+    TElem m_value;
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+};
+
+// 矩阵列表的批量访问视图，在MatrixView的基础上增加矩阵个数与相邻矩阵的间隔
+template<typename TElem>
+class BatchMatrixView
+{
+public:
+    using ElementType = TElem;
+
+    BatchMatrixView(TElem* data, std::size_t batchNum, std::size_t rowNum, std::size_t colNum,
+                    std::size_t batchStride, std::size_t rowStride, std::size_t colStride = 1)
+        : m_data(data)
+        , m_batchNum(batchNum)
+        , m_rowNum(rowNum)
+        , m_colNum(colNum)
+        , m_batchStride(batchStride)
+        , m_rowStride(rowStride)
+        , m_colStride(colStride)
+    {
+    }
+
+    std::size_t batchNum() const
+    {
+        return m_batchNum;
+    }
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    std::size_t batchStride() const
+    {
+        return m_batchStride;
+    }
+    std::size_t rowStride() const
+    {
+        return m_rowStride;
+    }
+    std::size_t colStride() const
+    {
+        return m_colStride;
+    }
+    TElem* data() const
+    {
+        return m_data;
+    }
+    bool isRowContiguous() const
+    {
+        return m_colStride == 1;
+    }
+    // 所有矩阵是否是同一个矩阵（矩阵间隔为0，如重复列表的求值结果），此时对共享矩阵的预处理只需要进行一次
+    bool isShared() const
+    {
+        return m_batchStride == 0;
+    }
+
+    TElem& operator()(std::size_t batchId, std::size_t row, std::size_t col) const
+    {
+        assert(batchId < m_batchNum && row < m_rowNum && col < m_colNum);
+        return m_data[batchId * m_batchStride + row * m_rowStride + col * m_colStride];
+    }
+    MatrixView<TElem> operator[](std::size_t batchId) const
+    {
+        assert(batchId < m_batchNum);
+        return MatrixView<TElem>(m_data + batchId * m_batchStride, m_rowNum, m_colNum, m_rowStride, m_colStride);
+    }
+
+private:
+    TElem* m_data;
+    std::size_t m_batchNum;
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+    std::size_t m_batchStride;
+    std::size_t m_rowStride;
+    std::size_t m_colStride;
+};
+
+} // namespace MetaNN
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <data/tags.hpp>
+#include <data/eval_cache.hpp>
+#include <data/matrix/matrix.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <cassert>
 
 namespace MetaNN
 {
 
+// 独热向量：只有hotPos处为1、其余为0的行向量，只保存位置
+// 与矩阵相乘时直接取出对应的行（见dot.hpp），确实需要稠密形式时由materialize()生成，结果缓存在对象中并在拷贝之间共享
 template<typename TElem, typename TDevice = DeviceTags::CPU>
 class OneHotVector;
 
@@ -22,6 +29,7 @@ public:
         : m_colNum(col)
         , m_hotPos(hotPos)
     {
+        assert(hotPos < col);
     }
     // 访问接口
     std::size_t rowNum() const
@@ -36,12 +44,34 @@ public:
     {
         return m_hotPos;
     }
+    const ElementType operator()([[maybe_unused]] std::size_t row, std::size_t col) const
+    {
+        assert(row == 0 && col < m_colNum);
+        return col == m_hotPos ? ElementType(1) : ElementType{};
+    }
+
+    // 求值接口
+    // 稠密形式，第一次调用时生成
+    Matrix<ElementType, DeviceType> materialize() const
+    {
+        return m_cache.get([this]() {
+            Matrix<ElementType, DeviceType> res(1, m_colNum);
+            auto row = res.mutableView().row(0);
+            std::fill(row.begin(), row.end(), ElementType{});
+            row[m_hotPos] = ElementType(1);
+            return res;
+        });
+    }
+    bool materialized() const
+    {
+        return m_cache.cached();
+    }
 
-    // 求值接口: todo
 private:
     std::size_t m_colNum;
     std::size_t m_hotPos;
-    // 求值结果缓存: todo
+    // 求值结果缓存
+    EvalCache<Matrix<ElementType, DeviceType>> m_cache;
 };
 
 } // namespace MetaNN
\ No newline at end of file
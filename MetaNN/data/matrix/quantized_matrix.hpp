@@ -0,0 +1,217 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <data/allocator.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/matrix_view.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 量化参数的粒度
+struct QuantizeTags
+{
+    struct PerTensor;   // 整个矩阵共用一组量化参数
+    struct PerRow;      // 每行一组量化参数
+};
+
+// int8量化矩阵：元素以int8保存，实际值 = scale * (q - zeroPoint)，占用内存约为float矩阵的1/4
+// 非对称量化：量化区间由数据的最小值与最大值（扩展到包含0）确定，0可以被精确表示
+// 构造后只读，不提供写操作；拷贝是浅拷贝，共享存储空间
+// ElementType是反量化后的元素类型，读操作返回反量化的值，与float矩阵的乘法见dot.hpp
+template<typename TElem, typename TDevice = DeviceTags::CPU, typename TGranularity = QuantizeTags::PerTensor>
+class QuantizedMatrix;
+
+template<typename TElem, typename TGranularity>
+class QuantizedMatrix<TElem, DeviceTags::CPU, TGranularity>
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type");
+    static_assert(std::is_floating_point_v<TElem>, "Only floating point matrices can be quantized");
+public:
+    using Category = CategoryTags::Matrix;
+    using ElementType = TElem;
+    using DeviceType = DeviceTags::CPU;
+    using Granularity = TGranularity;
+    static constexpr bool PerRow = std::is_same_v<TGranularity, QuantizeTags::PerRow>;
+public:
+    // 在给定的内存上构造，共享存储：values按行连续存放rowNum * colNum个量化值
+    // scales与zeroPoints在PerRow时各有rowNum个，在PerTensor时各有1个
+    QuantizedMatrix(std::size_t row, std::size_t col, ContinuousMemory<std::int8_t, DeviceType> values,
+                    ContinuousMemory<ElementType, DeviceType> scales, ContinuousMemory<std::int32_t, DeviceType> zeroPoints)
+        : m_rowNum(row)
+        , m_colNum(col)
+        , m_values(std::move(values))
+        , m_scales(std::move(scales))
+        , m_zeroPoints(std::move(zeroPoints))
+    {
+    }
+
+    // 访问接口
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    // 读操作，返回反量化的值
+    const ElementType operator()(std::size_t row, std::size_t col) const
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        auto q = static_cast<std::int32_t>(m_values.rawMemory()[row * m_colNum + col]);
+        return scale(row) * static_cast<ElementType>(q - zeroPoint(row));
+    }
+    // 第row行的量化参数
+    ElementType scale(std::size_t row) const
+    {
+        assert(row < m_rowNum);
+        return m_scales.rawMemory()[PerRow ? row : 0];
+    }
+    std::int32_t zeroPoint(std::size_t row) const
+    {
+        assert(row < m_rowNum);
+        return m_zeroPoints.rawMemory()[PerRow ? row : 0];
+    }
+
+    // 量化值的批量访问视图
+    MatrixView<const std::int8_t> quantizedView() const
+    {
+        return MatrixView<const std::int8_t>(m_values.rawMemory(), m_rowNum, m_colNum, m_colNum);
+    }
+
+    // 求值结果为其自身，见operator/quantize.hpp中的DataEvaluator_
+
+private:
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+    ContinuousMemory<std::int8_t, DeviceType> m_values;
+    ContinuousMemory<ElementType, DeviceType> m_scales;
+    ContinuousMemory<std::int32_t, DeviceType> m_zeroPoints;
+};
+
+// 量化矩阵的判断
+template<typename T>
+struct IsQuantizedMatrix_ : std::false_type {};
+
+template<typename TElem, typename TDevice, typename TGranularity>
+struct IsQuantizedMatrix_<QuantizedMatrix<TElem, TDevice, TGranularity>> : std::true_type {};
+
+template<typename T>
+concept QuantizedMatrixC = IsQuantizedMatrix_<std::remove_cvref_t<T>>::value;
+
+namespace NsQuantize
+{
+
+constexpr std::int32_t QuantMin = -128;
+constexpr std::int32_t QuantMax = 127;
+
+// 由数据范围确定量化参数，范围扩展到包含0；数据全为0时scale取1
+template<typename TElem>
+void chooseParams(TElem minVal, TElem maxVal, TElem& scale, std::int32_t& zeroPoint)
+{
+    minVal = std::min(minVal, TElem{});
+    maxVal = std::max(maxVal, TElem{});
+    scale = (maxVal - minVal) / static_cast<TElem>(QuantMax - QuantMin);
+    if (scale == TElem{})
+    {
+        scale = 1;
+        zeroPoint = 0;
+        return;
+    }
+    auto zp = static_cast<std::int32_t>(std::lrint(QuantMin - minVal / scale));
+    zeroPoint = std::clamp(zp, QuantMin, QuantMax);
+}
+
+template<typename TElem>
+std::int8_t quantizeValue(TElem val, TElem scale, std::int32_t zeroPoint)
+{
+    auto q = static_cast<std::int32_t>(std::lrint(val / scale)) + zeroPoint;
+    return static_cast<std::int8_t>(std::clamp(q, QuantMin, QuantMax));
+}
+
+// 将[rowBegin, rowEnd)行按同一组参数量化，写入行连续的pDest
+template<typename TMatrix>
+void quantizeRows(const TMatrix& dense, std::size_t rowBegin, std::size_t rowEnd, std::int8_t* pDest,
+                  typename TMatrix::ElementType& scale, std::int32_t& zeroPoint)
+{
+    using ElementType = typename TMatrix::ElementType;
+    ElementType minVal{};
+    ElementType maxVal{};
+    for (std::size_t i = rowBegin; i < rowEnd; ++i)
+    {
+        for (std::size_t j = 0; j < dense.colNum(); ++j)
+        {
+            minVal = std::min<ElementType>(minVal, dense(i, j));
+            maxVal = std::max<ElementType>(maxVal, dense(i, j));
+        }
+    }
+    chooseParams(minVal, maxVal, scale, zeroPoint);
+    for (std::size_t i = rowBegin; i < rowEnd; ++i)
+    {
+        for (std::size_t j = 0; j < dense.colNum(); ++j)
+        {
+            *pDest++ = quantizeValue<ElementType>(dense(i, j), scale, zeroPoint);
+        }
+    }
+}
+
+} // namespace NsQuantize
+
+// 稠密矩阵转换为量化矩阵
+template<typename TGranularity = QuantizeTags::PerTensor, typename TMatrix>
+    requires IsMatrixC<TMatrix>
+auto makeQuantized(const TMatrix& dense)
+{
+    using ElementType = typename TMatrix::ElementType;
+    using ResType = QuantizedMatrix<ElementType, DeviceTags::CPU, TGranularity>;
+    const std::size_t rowNum = dense.rowNum();
+    const std::size_t colNum = dense.colNum();
+    const std::size_t paramNum = ResType::PerRow ? rowNum : 1;
+    ContinuousMemory<std::int8_t, DeviceTags::CPU> valueMem(rowNum * colNum, "QuantizedMatrix");
+    ContinuousMemory<ElementType, DeviceTags::CPU> scaleMem(paramNum, "QuantizedMatrix");
+    ContinuousMemory<std::int32_t, DeviceTags::CPU> zeroPointMem(paramNum, "QuantizedMatrix");
+    if constexpr (ResType::PerRow)
+    {
+        for (std::size_t i = 0; i < rowNum; ++i)
+        {
+            NsQuantize::quantizeRows(dense, i, i + 1, valueMem.rawMemory() + i * colNum,
+                                     scaleMem.rawMemory()[i], zeroPointMem.rawMemory()[i]);
+        }
+    }
+    else
+    {
+        NsQuantize::quantizeRows(dense, 0, rowNum, valueMem.rawMemory(), scaleMem.rawMemory()[0], zeroPointMem.rawMemory()[0]);
+    }
+    return ResType(rowNum, colNum, std::move(valueMem), std::move(scaleMem), std::move(zeroPointMem));
+}
+
+// 量化矩阵转换为稠密矩阵（反量化）
+template<typename TElem, typename TGranularity>
+Matrix<TElem, DeviceTags::CPU> makeDense(const QuantizedMatrix<TElem, DeviceTags::CPU, TGranularity>& quantized)
+{
+    Matrix<TElem, DeviceTags::CPU> res(quantized.rowNum(), quantized.colNum());
+    const auto src = quantized.quantizedView();
+    const auto dest = res.mutableView();
+    for (std::size_t i = 0; i < quantized.rowNum(); ++i)
+    {
+        const TElem scale = quantized.scale(i);
+        const std::int32_t zeroPoint = quantized.zeroPoint(i);
+        const std::int8_t* pSrc = src.row(i).data();
+        TElem* pDest = dest.row(i).data();
+        for (std::size_t j = 0; j < quantized.colNum(); ++j)
+        {
+            pDest[j] = scale * static_cast<TElem>(static_cast<std::int32_t>(pSrc[j]) - zeroPoint);
+        }
+    }
+    return res;
+}
+
+} // namespace MetaNN
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <data/allocator.hpp>
+#include <data/matrix/matrix.hpp>
+#include <span>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 稀疏矩阵的批量访问视图（CSR格式），不持有内存
+// rowOffsets共rowNum + 1个，第i行非零元素在colIndices与values中的位置区间为[rowOffsets[i], rowOffsets[i + 1])
+// 位置是相对于colIndices与values起始地址的绝对位置，rowOffsets[0]不一定为0（比如稀疏矩阵列表中的某一个矩阵）
+template<typename TElem>
+class SparseMatrixView
+{
+public:
+    using ElementType = TElem;
+
+    SparseMatrixView(std::size_t rowNum, std::size_t colNum, const std::size_t* rowOffsets,
+                     const std::size_t* colIndices, TElem* values)
+        : m_rowNum(rowNum)
+        , m_colNum(colNum)
+        , m_rowOffsets(rowOffsets)
+        , m_colIndices(colIndices)
+        , m_values(values)
+    {
+    }
+
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    std::size_t nonZeroCount() const
+    {
+        return m_rowOffsets[m_rowNum] - m_rowOffsets[0];
+    }
+    // 第rowId行非零元素的列号（升序）与值
+    std::span<const std::size_t> rowIndices(std::size_t rowId) const
+    {
+        assert(rowId < m_rowNum);
+        return std::span<const std::size_t>(m_colIndices + m_rowOffsets[rowId], m_colIndices + m_rowOffsets[rowId + 1]);
+    }
+    std::span<TElem> rowValues(std::size_t rowId) const
+    {
+        assert(rowId < m_rowNum);
+        return std::span<TElem>(m_values + m_rowOffsets[rowId], m_values + m_rowOffsets[rowId + 1]);
+    }
+
+private:
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+    const std::size_t* m_rowOffsets;
+    const std::size_t* m_colIndices;
+    TElem* m_values;
+};
+
+// 稀疏矩阵：按行压缩存储（CSR），只保存非零元素，适用于非常稀疏的输入特征
+// 构造后只读，不提供写操作；拷贝是浅拷贝，共享存储空间
+// 与稠密矩阵（列表）的乘法只访问非零元素，不会展开为稠密矩阵计算；其他运算求值时展开为稠密矩阵（见evaluate.hpp）
+template<typename TElem>
+class SparseMatrix<TElem, DeviceTags::CPU>
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type");
+public:
+    using Category = CategoryTags::Matrix;
+    using ElementType = TElem;
+    using DeviceType = DeviceTags::CPU;
+public:
+    // 在给定的CSR内存上构造，共享存储，rowOffsets的含义见SparseMatrixView
+    SparseMatrix(std::size_t row, std::size_t col, ContinuousMemory<std::size_t, DeviceType> rowOffsets,
+                 ContinuousMemory<std::size_t, DeviceType> colIndices, ContinuousMemory<ElementType, DeviceType> values)
+        : m_rowNum(row)
+        , m_colNum(col)
+        , m_rowOffsets(std::move(rowOffsets))
+        , m_colIndices(std::move(colIndices))
+        , m_values(std::move(values))
+    {
+    }
+
+    // 访问接口
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    std::size_t nonZeroCount() const
+    {
+        return view().nonZeroCount();
+    }
+    // 读操作，未保存的元素为0，在行内二分查找
+    const ElementType operator()(std::size_t row, std::size_t col) const
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        auto indices = view().rowIndices(row);
+        auto it = std::lower_bound(indices.begin(), indices.end(), col);
+        if (it == indices.end() || *it != col)
+        {
+            return ElementType{};
+        }
+        return view().rowValues(row)[it - indices.begin()];
+    }
+
+    SparseMatrixView<const ElementType> view() const
+    {
+        return SparseMatrixView<const ElementType>(m_rowNum, m_colNum, m_rowOffsets.rawMemory(),
+                                                   m_colIndices.rawMemory(), m_values.rawMemory());
+    }
+
+private:
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+    ContinuousMemory<std::size_t, DeviceType> m_rowOffsets;
+    ContinuousMemory<std::size_t, DeviceType> m_colIndices;
+    ContinuousMemory<ElementType, DeviceType> m_values;
+};
+
+// 稀疏矩阵的判断
+template<typename T>
+struct IsSparseMatrix_ : std::false_type {};
+
+template<typename TElem, typename TDevice>
+struct IsSparseMatrix_<SparseMatrix<TElem, TDevice>> : std::true_type {};
+
+template<typename T>
+concept SparseMatrixC = IsSparseMatrix_<std::remove_cvref_t<T>>::value;
+
+// 由CSR数组复制构造稀疏矩阵，rowOffsets共row + 1个且从0开始，每行的列号需要升序排列
+template<typename TElem>
+SparseMatrix<TElem, DeviceTags::CPU> makeSparseMatrix(std::size_t row, std::size_t col,
+                                                      std::span<const std::size_t> rowOffsets,
+                                                      std::span<const std::size_t> colIndices,
+                                                      std::span<const TElem> values)
+{
+    assert(rowOffsets.size() == row + 1 && rowOffsets[0] == 0);
+    assert(colIndices.size() == rowOffsets[row] && values.size() == rowOffsets[row]);
+    ContinuousMemory<std::size_t, DeviceTags::CPU> offsetMem(row + 1, "SparseMatrix");
+    ContinuousMemory<std::size_t, DeviceTags::CPU> indexMem(colIndices.size(), "SparseMatrix");
+    ContinuousMemory<TElem, DeviceTags::CPU> valueMem(values.size(), "SparseMatrix");
+    std::ranges::copy(rowOffsets, offsetMem.rawMemory());
+    std::ranges::copy(colIndices, indexMem.rawMemory());
+    std::ranges::copy(values, valueMem.rawMemory());
+    for (std::size_t i = 0; i < row; ++i)
+    {
+        assert(std::is_sorted(indexMem.rawMemory() + rowOffsets[i], indexMem.rawMemory() + rowOffsets[i + 1]));
+        assert(rowOffsets[i] == rowOffsets[i + 1] || indexMem.rawMemory()[rowOffsets[i + 1] - 1] < col);
+    }
+    return SparseMatrix<TElem, DeviceTags::CPU>(row, col, std::move(offsetMem), std::move(indexMem), std::move(valueMem));
+}
+
+namespace NsSparse
+{
+
+// 统计稠密矩阵中非零元素的数量
+template<typename TMatrix>
+std::size_t countNonZeros(const TMatrix& dense)
+{
+    using ElementType = typename TMatrix::ElementType;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < dense.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < dense.colNum(); ++j)
+        {
+            count += (dense(i, j) != ElementType{});
+        }
+    }
+    return count;
+}
+
+// 将稠密矩阵的非零元素依次写入CSR数组，rowOffsets写入rowNum + 1个位置（从base开始），返回写入的非零元素数量
+template<typename TMatrix>
+std::size_t fillCsr(const TMatrix& dense, std::size_t base, std::size_t* rowOffsets, std::size_t* colIndices,
+                    typename TMatrix::ElementType* values)
+{
+    using ElementType = typename TMatrix::ElementType;
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < dense.rowNum(); ++i)
+    {
+        rowOffsets[i] = base + pos;
+        for (std::size_t j = 0; j < dense.colNum(); ++j)
+        {
+            ElementType val = dense(i, j);
+            if (val != ElementType{})
+            {
+                colIndices[pos] = j;
+                values[pos] = val;
+                ++pos;
+            }
+        }
+    }
+    rowOffsets[dense.rowNum()] = base + pos;
+    return pos;
+}
+
+// 将稀疏矩阵写入行连续的稠密视图，未保存的元素写为0
+template<typename TElem, typename TSrc>
+void scatter(const MatrixView<TElem>& dest, const SparseMatrixView<TSrc>& src)
+{
+    assert(dest.rowNum() == src.rowNum() && dest.colNum() == src.colNum());
+    for (std::size_t i = 0; i < src.rowNum(); ++i)
+    {
+        auto row = dest.row(i);
+        std::ranges::fill(row, TElem{});
+        auto indices = src.rowIndices(i);
+        auto values = src.rowValues(i);
+        for (std::size_t p = 0; p < indices.size(); ++p)
+        {
+            row[indices[p]] = values[p];
+        }
+    }
+}
+
+} // namespace NsSparse
+
+// 稠密矩阵转换为稀疏矩阵，只保存非零元素
+template<typename TMatrix>
+    requires IsMatrixC<TMatrix>
+auto makeSparse(const TMatrix& dense)
+{
+    using ElementType = typename TMatrix::ElementType;
+    std::size_t nonZeros = NsSparse::countNonZeros(dense);
+    ContinuousMemory<std::size_t, DeviceTags::CPU> offsetMem(dense.rowNum() + 1, "SparseMatrix");
+    ContinuousMemory<std::size_t, DeviceTags::CPU> indexMem(nonZeros, "SparseMatrix");
+    ContinuousMemory<ElementType, DeviceTags::CPU> valueMem(nonZeros, "SparseMatrix");
+    NsSparse::fillCsr(dense, 0, offsetMem.rawMemory(), indexMem.rawMemory(), valueMem.rawMemory());
+    return SparseMatrix<ElementType, DeviceTags::CPU>(dense.rowNum(), dense.colNum(), std::move(offsetMem),
+                                                      std::move(indexMem), std::move(valueMem));
+}
+
+// 稀疏矩阵转换为稠密矩阵
+template<typename TElem>
+Matrix<TElem, DeviceTags::CPU> makeDense(const SparseMatrix<TElem, DeviceTags::CPU>& sparse)
+{
+    Matrix<TElem, DeviceTags::CPU> res(sparse.rowNum(), sparse.colNum());
+    NsSparse::scatter(res.mutableView(), sparse.view());
+    return res;
+}
+
+} // namespace MetaNN
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <data/allocator.hpp>
+#include <data/copy_on_write.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/matrix_view.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 分块存储的矩阵：TiledMatrix<TElem, DeviceTags::CPU, TileSize>
+// 元素按TileSize * TileSize的块存放，块之间按行排列，块内按行紧密排列，每个块占用一段连续内存
+// 矩阵乘法、转置等按块处理的计算核心每次只访问几个块，对于很大的矩阵比按行存储有更好的局部性
+// 行列数不是TileSize整数倍时，边缘块的多余部分填充为0并保持为0，计算核心因此可以始终按完整的块计算
+// 拷贝是浅拷贝，写操作与Matrix相同，底层内存被共享时先脱离共享
+template<typename TElem, std::size_t TileSize>
+class TiledMatrix<TElem, DeviceTags::CPU, TileSize>
+{
+    static_assert(std::is_same_v<std::remove_cvref_t<TElem>, TElem>, "TElem is not an available type");
+    static_assert(TileSize > 0, "Tile size can not be 0");
+public:
+    using Category = CategoryTags::Matrix;
+    using ElementType = TElem;
+    using DeviceType = DeviceTags::CPU;
+
+    static constexpr std::size_t Tile = TileSize;
+    static constexpr std::size_t TileElemNum = TileSize * TileSize;
+public:
+    // 元素初始化为0
+    TiledMatrix(std::size_t row = 0, std::size_t col = 0)
+        : m_mem(tileCount(row) * tileCount(col) * TileElemNum, "TiledMatrix")
+        , m_rowNum(row)
+        , m_colNum(col)
+    {
+        std::fill(m_mem.rawMemory(), m_mem.rawMemory() + tileCount(row) * tileCount(col) * TileElemNum, ElementType{});
+    }
+
+    // 访问接口
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    // 块的行数与列数
+    std::size_t tileRowNum() const
+    {
+        return tileCount(m_rowNum);
+    }
+    std::size_t tileColNum() const
+    {
+        return tileCount(m_colNum);
+    }
+    void setValue(std::size_t row, std::size_t col, ElementType val)
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        m_mem.rawMemory()[offset(row, col)] = val;
+    }
+    const auto operator()(std::size_t row, std::size_t col) const
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        return m_mem.rawMemory()[offset(row, col)];
+    }
+    bool availableForWrite() const
+    {
+        return m_mem.availableForWrite();
+    }
+
+    // 第(tileRow, tileCol)个块的视图，包含边缘块中填充的部分，形状总是TileSize * TileSize
+    // 可写视图不能在填充部分写入非0值
+    MatrixView<const ElementType> tile(std::size_t tileRow, std::size_t tileCol) const
+    {
+        assert(tileRow < tileRowNum() && tileCol < tileColNum());
+        return MatrixView<const ElementType>(m_mem.rawMemory() + (tileRow * tileColNum() + tileCol) * TileElemNum,
+                                             TileSize, TileSize, TileSize);
+    }
+    MatrixView<ElementType> mutableTile(std::size_t tileRow, std::size_t tileCol)
+    {
+        assert(tileRow < tileRowNum() && tileCol < tileColNum());
+        if (!availableForWrite()) [[unlikely]]
+        {
+            detach();
+        }
+        return MatrixView<ElementType>(m_mem.rawMemory() + (tileRow * tileColNum() + tileCol) * TileElemNum,
+                                       TileSize, TileSize, TileSize);
+    }
+
+    // 转置：逐块转置并交换块的位置，复制为新的分块矩阵（分块存储无法只通过交换行列间隔得到转置视图）
+    TiledMatrix transpose() const
+    {
+        TiledMatrix res(m_colNum, m_rowNum);
+        for (std::size_t ti = 0; ti < tileRowNum(); ++ti)
+        {
+            for (std::size_t tj = 0; tj < tileColNum(); ++tj)
+            {
+                const ElementType* pSrc = tile(ti, tj).data();
+                ElementType* pDest = res.m_mem.rawMemory() + (tj * res.tileColNum() + ti) * TileElemNum;
+                for (std::size_t i = 0; i < TileSize; ++i)
+                {
+                    for (std::size_t j = 0; j < TileSize; ++j)
+                    {
+                        pDest[j * TileSize + i] = pSrc[i * TileSize + j];
+                    }
+                }
+            }
+        }
+        return res;
+    }
+
+private:
+    static std::size_t tileCount(std::size_t len)
+    {
+        return (len + TileSize - 1) / TileSize;
+    }
+    std::size_t offset(std::size_t row, std::size_t col) const
+    {
+        return ((row / TileSize) * tileColNum() + col / TileSize) * TileElemNum + (row % TileSize) * TileSize + col % TileSize;
+    }
+    void detach()
+    {
+        const std::size_t size = tileRowNum() * tileColNum() * TileElemNum;
+        ContinuousMemory<ElementType, DeviceType> mem(size, "TiledMatrix");
+        std::copy(m_mem.rawMemory(), m_mem.rawMemory() + size, mem.rawMemory());
+        m_mem = std::move(mem);
+        CopyOnWrite::recordDetach<Category>(size * sizeof(ElementType));
+    }
+
+private:
+    ContinuousMemory<ElementType, DeviceType> m_mem;
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+};
+
+// 分块矩阵的判断
+template<typename T>
+struct IsTiledMatrix_ : std::false_type {};
+
+template<typename TElem, typename TDevice, std::size_t TileSize>
+struct IsTiledMatrix_<TiledMatrix<TElem, TDevice, TileSize>> : std::true_type {};
+
+template<typename T>
+concept TiledMatrixC = IsTiledMatrix_<std::remove_cvref_t<T>>::value;
+
+// 按行存储的矩阵转换为分块矩阵
+template<std::size_t TileSize = 64, typename TMatrix>
+    requires IsMatrixC<TMatrix>
+auto makeTiled(const TMatrix& dense)
+{
+    using ElementType = typename TMatrix::ElementType;
+    TiledMatrix<ElementType, DeviceTags::CPU, TileSize> res(dense.rowNum(), dense.colNum());
+    for (std::size_t ti = 0; ti < res.tileRowNum(); ++ti)
+    {
+        const std::size_t rowBegin = ti * TileSize;
+        const std::size_t rowEnd = std::min(rowBegin + TileSize, dense.rowNum());
+        for (std::size_t tj = 0; tj < res.tileColNum(); ++tj)
+        {
+            const std::size_t colBegin = tj * TileSize;
+            const std::size_t colEnd = std::min(colBegin + TileSize, dense.colNum());
+            const auto dest = res.mutableTile(ti, tj);
+            for (std::size_t i = rowBegin; i < rowEnd; ++i)
+            {
+                for (std::size_t j = colBegin; j < colEnd; ++j)
+                {
+                    dest(i - rowBegin, j - colBegin) = dense(i, j);
+                }
+            }
+        }
+    }
+    return res;
+}
+
+// 分块矩阵转换为按行存储的矩阵
+template<typename TElem, std::size_t TileSize>
+Matrix<TElem, DeviceTags::CPU> makeDense(const TiledMatrix<TElem, DeviceTags::CPU, TileSize>& tiled)
+{
+    Matrix<TElem, DeviceTags::CPU> res(tiled.rowNum(), tiled.colNum());
+    const auto dest = res.mutableView();
+    for (std::size_t ti = 0; ti < tiled.tileRowNum(); ++ti)
+    {
+        const std::size_t rowBegin = ti * TileSize;
+        const std::size_t rowEnd = std::min(rowBegin + TileSize, tiled.rowNum());
+        for (std::size_t tj = 0; tj < tiled.tileColNum(); ++tj)
+        {
+            const std::size_t colBegin = tj * TileSize;
+            const std::size_t colCount = std::min(TileSize, tiled.colNum() - colBegin);
+            const auto src = tiled.tile(ti, tj);
+            for (std::size_t i = rowBegin; i < rowEnd; ++i)
+            {
+                std::copy_n(src.row(i - rowBegin).data(), colCount, dest.row(i).data() + colBegin);
+            }
+        }
+    }
+    return res;
+}
+
+} // namespace MetaNN
@@ -3,12 +3,19 @@
 #include <data/tags.hpp>
 #include <data/traits.hpp>
 #include <data/scalar.hpp>
+#include <data/eval_cache.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/matrix_view.hpp>
+#include <algorithm>
 #include <type_traits>
+#include <cassert>
 
 namespace MetaNN
 {
 
 // 平凡矩阵：所有元素值都一样的矩阵
+// 只保存一个元素值，逐元素运算、矩阵乘法等通过view()得到的广播视图或元素值直接计算，不需要展开
+// 确实需要稠密形式时由materialize()生成，结果缓存在对象中并在拷贝之间共享，重复使用时不再生成
 template<typename TElem, typename TDevice = DeviceTags::CPU, typename TScalar = Scalar<TElem, TDevice>>
 class TrivialMatrix;
 
@@ -42,14 +49,44 @@ public:
     {
         return m_val;
     }
-    
-    // 求值接口: todo
+    ElementType value() const
+    {
+        return static_cast<ElementType>(m_val.value());
+    }
+    const ElementType operator()([[maybe_unused]] std::size_t row, [[maybe_unused]] std::size_t col) const
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        return value();
+    }
+
+    // 求值接口
+    BroadcastView<ElementType> view() const
+    {
+        return BroadcastView<ElementType>(value(), m_rowNum, m_colNum);
+    }
+    // 稠密形式，第一次调用时生成
+    Matrix<ElementType, DeviceType> materialize() const
+    {
+        return m_cache.get([this]() {
+            Matrix<ElementType, DeviceType> res(m_rowNum, m_colNum);
+            for (auto row : res.mutableView())
+            {
+                std::fill(row.begin(), row.end(), value());
+            }
+            return res;
+        });
+    }
+    bool materialized() const
+    {
+        return m_cache.cached();
+    }
 
 private:
     std::size_t m_rowNum;
     std::size_t m_colNum;
     TScalar m_val;
-    // 求值结果缓存: todo
+    // 求值结果缓存
+    EvalCache<Matrix<ElementType, DeviceType>> m_cache;
 };
 
 // 创建平凡矩阵，简化构造过程
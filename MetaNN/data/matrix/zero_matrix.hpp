@@ -1,12 +1,19 @@
 #pragma once
 
 #include <data/tags.hpp>
+#include <data/eval_cache.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/matrix_view.hpp>
+#include <algorithm>
 #include <type_traits>
+#include <cassert>
 
 namespace MetaNN
 {
 
 // 全零矩阵：即矩阵中元素全为0的平凡矩阵
+// 不保存元素，参与计算与求值的方式同平凡矩阵（见trivial_matrix.hpp）
+// 矩阵乘法不读取另一个操作数，直接生成全零的稠密矩阵（见dot.hpp）
 template<typename TElem, typename TDevice = DeviceTags::CPU>
 class ZeroMatrix;
 
@@ -35,11 +42,43 @@ public:
         return m_colNum;
     }
 
-    // 求值接口: todo
+    ElementType value() const
+    {
+        return ElementType{};
+    }
+    const ElementType operator()([[maybe_unused]] std::size_t row, [[maybe_unused]] std::size_t col) const
+    {
+        assert(row < m_rowNum && col < m_colNum);
+        return ElementType{};
+    }
+
+    // 求值接口
+    BroadcastView<ElementType> view() const
+    {
+        return BroadcastView<ElementType>(ElementType{}, m_rowNum, m_colNum);
+    }
+    // 稠密形式，第一次调用时生成
+    Matrix<ElementType, DeviceType> materialize() const
+    {
+        return m_cache.get([this]() {
+            Matrix<ElementType, DeviceType> res(m_rowNum, m_colNum);
+            for (auto row : res.mutableView())
+            {
+                std::fill(row.begin(), row.end(), ElementType{});
+            }
+            return res;
+        });
+    }
+    bool materialized() const
+    {
+        return m_cache.cached();
+    }
+
 private:
     std::size_t m_rowNum;
     std::size_t m_colNum;
-    // 求值结果缓存: todo
+    // 求值结果缓存
+    EvalCache<Matrix<ElementType, DeviceType>> m_cache;
 };
 
 } // namespace MetaNN
\ No newline at end of file
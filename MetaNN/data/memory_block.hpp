@@ -0,0 +1,91 @@
+#pragma once
+
+#include <data/memory_policy.hpp>
+#include <data/memory_tracker.hpp>
+#include <memory>
+#include <atomic>
+
+namespace MetaNN
+{
+
+// 分配器返回的原始内存，记录了归还这块内存所需的全部信息
+// 各分配器的allocate(bytes, alignment)都返回该类型，由ContinuousMemory在不再使用时调用release归还
+struct RawMemory
+{
+    void* ptr = nullptr;
+    std::size_t size = 0;           // 实际占用的字节数，对于内存池就是大小类别
+    std::size_t alignment = 0;
+    void* context = nullptr;        // 分配器相关的上下文，比如所属的线程缓存或者竞技场
+    void (*deallocate)(const RawMemory&) = nullptr;
+
+    void release() const
+    {
+        if (deallocate)
+        {
+            deallocate(*this);
+        }
+    }
+};
+
+// 引用计数，根据内存策略选择原子或者非原子实现
+template<typename TRefCountTag>
+class RefCounter;
+
+template<>
+class RefCounter<MemoryPolicy::RefCountTypeCategory::Atomic>
+{
+public:
+    void increase()
+    {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    // 返回减少后的计数
+    std::size_t decrease()
+    {
+        return m_count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+    std::size_t count() const
+    {
+        return m_count.load(std::memory_order_acquire);
+    }
+private:
+    std::atomic<std::size_t> m_count{1};
+};
+
+template<>
+class RefCounter<MemoryPolicy::RefCountTypeCategory::NonAtomic>
+{
+public:
+    void increase()
+    {
+        ++m_count;
+    }
+    std::size_t decrease()
+    {
+        return --m_count;
+    }
+    std::size_t count() const
+    {
+        return m_count;
+    }
+private:
+    std::size_t m_count = 1;
+};
+
+// 侵入式控制块：通常与数据位于同一次分配中，放在数据之后，从而不会因为对齐要求浪费数据之前的空间
+// 接管外部内存时控制块单独分配，通过keepAlive维持外部内存的生命周期
+// Tracked为true时保存内存分配跟踪信息，否则不占用空间
+template<typename TRefCounter, bool Tracked = false>
+struct MemoryBlockHeader
+{
+    TRefCounter refCount;
+    void* elements = nullptr;       // 数据起始位置
+    std::size_t elementCount = 0;   // 需要析构的元素数量，外部内存不由控制块析构，为0
+    RawMemory raw;                  // 控制块所在的内存，控制块析构后归还
+    std::shared_ptr<void> keepAlive;
+    bool readOnly = false;          // 只读内存（比如只读映射的文件）不能写入
+    bool sharedSource = false;      // 外部内存可能同时被其他控制块使用（比如同一映射上的多个数据），keepAlive未被共享时才能写入
+    [[no_unique_address]] AllocationTrackInfo<Tracked> track;
+};
+
+} // namespace MetaNN
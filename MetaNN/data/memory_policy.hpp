@@ -0,0 +1,132 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <policy/policy_container.hpp>
+#include <policy/policy_selector.hpp>
+#include <policy/policy_macro_begin.hpp>
+
+namespace MetaNN
+{
+
+// 内存分配相关的策略
+struct MemoryPolicy
+{
+    using MajorClass = MemoryPolicy;
+
+    struct AllocatorTypeCategory
+    {
+        struct Heap;        // 每次分配都直接从堆上申请，释放时直接归还
+        struct Pool;        // 按大小类别缓存释放的内存块，供后续相同大小类别的分配复用
+        struct ThreadCache; // 在内存池之前增加线程缓存，多线程分配释放时避免锁竞争
+        struct HugePage;    // 不小于HugePageThreshold的内存块使用大页，更小的直接从堆上申请
+    };
+    using Allocator = AllocatorTypeCategory::Heap;
+
+    // 大页分配器请求大页的方式
+    struct HugePageModeTypeCategory
+    {
+        struct Transparent; // 通过madvise请求透明大页
+        struct Explicit;    // 先尝试显式大页（MAP_HUGETLB），失败时退回透明大页
+    };
+    using HugePageMode = HugePageModeTypeCategory::Transparent;
+
+    // 使用大页的内存块字节数阈值，默认为一个大页（2MB）
+    struct HugePageThresholdValueCategory;
+    static constexpr std::size_t HugePageThreshold = std::size_t(2) << 20;
+
+    // 分配的内存块起始地址的对齐字节数：2的幂次，不小于元素类型的对齐要求，不超过页大小（4096）
+    // 默认对齐到缓存行（64字节），同时满足AVX-512的对齐加载要求
+    struct AlignmentValueCategory;
+    static constexpr std::size_t Alignment = 64;
+
+    // 矩阵（包括矩阵列表中的矩阵）每行起始位置的对齐字节数：行长度向上取整，使每行占用的字节数是该值的整数倍
+    // 与Alignment配合使每一行都从对齐的地址开始，按行处理的循环没有跨缓存行的行首，也不需要为每行处理未对齐的开头
+    // 0表示不填充，各行紧密排列；非0时必须是2的幂次，是元素大小的整数倍，且不超过Alignment
+    struct RowAlignmentValueCategory;
+    static constexpr std::size_t RowAlignment = 0;
+
+    // 内存块引用计数的实现：仅在单线程中使用的数据可以选择非原子计数，避免原子操作的开销
+    struct RefCountTypeCategory
+    {
+        struct Atomic;
+        struct NonAtomic;
+    };
+    using RefCount = RefCountTypeCategory::Atomic;
+
+    // 是否跟踪内存分配（见memory_tracker.hpp），定义宏METANN_TRACK_MEMORY时默认打开
+    struct TrackingTypeCategory
+    {
+        struct Off;
+        struct On;
+    };
+#ifdef METANN_TRACK_MEMORY
+    using Tracking = TrackingTypeCategory::On;
+#else
+    using Tracking = TrackingTypeCategory::Off;
+#endif
+};
+
+TypePolicyObj(PHeapAllocator,           MemoryPolicy, Allocator, Heap);
+TypePolicyObj(PPoolAllocator,           MemoryPolicy, Allocator, Pool);
+TypePolicyObj(PThreadCacheAllocator,    MemoryPolicy, Allocator, ThreadCache);
+TypePolicyObj(PHugePageAllocator,       MemoryPolicy, Allocator, HugePage);
+TypePolicyObj(PTransparentHugePage,     MemoryPolicy, HugePageMode, Transparent);
+TypePolicyObj(PExplicitHugePage,        MemoryPolicy, HugePageMode, Explicit);
+ValuePolicyTemplate(PHugePageThresholdIs, MemoryPolicy, HugePageThreshold);
+ValuePolicyTemplate(PAlignmentIs,       MemoryPolicy, Alignment);
+ValuePolicyTemplate(PRowAlignmentIs,    MemoryPolicy, RowAlignment);
+TypePolicyObj(PAtomicRefCount,          MemoryPolicy, RefCount, Atomic);
+TypePolicyObj(PNonAtomicRefCount,       MemoryPolicy, RefCount, NonAtomic);
+TypePolicyObj(PTrackAllocation,         MemoryPolicy, Tracking, On);
+TypePolicyObj(PNoAllocationTracking,    MemoryPolicy, Tracking, Off);
+
+// 为特定元素类型与设备指定内存策略，默认使用空策略容器（即MemoryPolicy中的默认值）
+// 需要修改时对其进行特化，特化必须在对应数据类型首次使用之前可见，比如：
+//      template<> struct DataMemoryPolicy_<float, DeviceTags::CPU> { using type = PolicyContainer<PPoolAllocator>; };
+template<typename TElem, typename TDevice>
+struct DataMemoryPolicy_
+{
+    using type = PolicyContainer<>;
+};
+
+template<typename TElem, typename TDevice>
+using DataMemoryPolicy = PolicySelect<MemoryPolicy, typename DataMemoryPolicy_<TElem, TDevice>::type>;
+
+// 页大小，也是可以配置的最大对齐
+constexpr std::size_t PageSize = 4096;
+
+// 元素类型与设备对应的内存块对齐
+template<typename TElem, typename TDevice>
+constexpr std::size_t MemoryAlignment = []
+{
+    constexpr std::size_t alignment = DataMemoryPolicy<TElem, TDevice>::Alignment;
+    static_assert((alignment & (alignment - 1)) == 0, "Alignment must be a power of 2");
+    static_assert(alignment >= alignof(TElem), "Alignment can not be less than alignment of element type");
+    static_assert(alignment <= PageSize, "Alignment can not exceed page size");
+    return alignment;
+}();
+
+// 按RowAlignment填充后的行长度（元素数量），即矩阵相邻两行起始位置的间隔
+template<typename TElem, typename TDevice>
+constexpr std::size_t paddedRowLen(std::size_t colNum)
+{
+    constexpr std::size_t rowAlignment = DataMemoryPolicy<TElem, TDevice>::RowAlignment;
+    if constexpr (rowAlignment == 0)
+    {
+        return colNum;
+    }
+    else
+    {
+        static_assert((rowAlignment & (rowAlignment - 1)) == 0, "Row alignment must be a power of 2");
+        static_assert(rowAlignment % sizeof(TElem) == 0, "Row alignment must be a multiple of element size");
+        static_assert(rowAlignment <= MemoryAlignment<TElem, TDevice>, "Row alignment can not exceed memory alignment");
+        constexpr std::size_t step = rowAlignment / sizeof(TElem);
+        return (colNum + step - 1) / step * step;
+    }
+}
+
+} // namespace MetaNN
+
+#include <policy/policy_macro_end.hpp>
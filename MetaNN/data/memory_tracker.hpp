@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <bit>
+#include <algorithm>
+#include <cstddef>
+
+namespace MetaNN
+{
+
+// 内存分配跟踪：统计ContinuousMemory分配的数据内存（不含控制块），用于回答一次前向传播分配了多少内存、峰值是多少、由谁分配
+// 通过内存策略PTrackAllocation为元素类型打开，或者定义宏METANN_TRACK_MEMORY为所有元素类型默认打开
+// 未打开时不记录任何信息，控制块中也不保存跟踪信息，没有任何开销
+// 分配归属于当前线程最内层的AllocationTagScope（比如某个操作），没有时归属于创建内存的数据类型
+
+// 每个归属标签的统计
+struct AllocationTagStatistics
+{
+    std::size_t allocateCount = 0;  // 分配次数
+    std::size_t allocatedBytes = 0; // 累计分配的字节数
+    std::size_t liveBytes = 0;      // 当前仍在使用的字节数
+};
+
+struct MemoryTrackerStatistics
+{
+    // 分配大小的直方图：第i个桶统计字节数在[2^(i-1), 2^i)区间内的分配次数，第0个桶统计大小为0的分配
+    static constexpr std::size_t HistogramBuckets = 65;
+
+    std::size_t allocateCount = 0;  // 分配次数
+    std::size_t freeCount = 0;      // 释放次数
+    std::size_t allocatedBytes = 0; // 累计分配的字节数
+    std::size_t liveBytes = 0;      // 当前仍在使用的字节数
+    std::size_t peakBytes = 0;      // 使用字节数的峰值
+    std::array<std::size_t, HistogramBuckets> histogram{};
+    std::map<std::string, AllocationTagStatistics> tags;
+
+    static std::size_t bucketOf(std::size_t bytes)
+    {
+        return std::bit_width(bytes);
+    }
+};
+
+// 控制块中保存的跟踪信息，未打开跟踪时为空
+template<bool Enabled>
+struct AllocationTrackInfo
+{
+};
+
+template<>
+struct AllocationTrackInfo<true>
+{
+    const char* tag = nullptr;
+    std::size_t bytes = 0;
+};
+
+class MemoryTracker
+{
+public:
+    static constexpr const char* UnknownTag = "unknown";
+
+    // 记录一次分配，返回实际归属的标签
+    static const char* recordAllocate(std::size_t bytes, const char* dataTag)
+    {
+        const char* tag = currentTag() ? currentTag() : (dataTag ? dataTag : UnknownTag);
+        State& state = instance();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        MemoryTrackerStatistics& stats = state.stats;
+        ++stats.allocateCount;
+        stats.allocatedBytes += bytes;
+        stats.liveBytes += bytes;
+        stats.peakBytes = std::max(stats.peakBytes, stats.liveBytes);
+        ++stats.histogram[MemoryTrackerStatistics::bucketOf(bytes)];
+        AllocationTagStatistics& tagStats = stats.tags[tag];
+        ++tagStats.allocateCount;
+        tagStats.allocatedBytes += bytes;
+        tagStats.liveBytes += bytes;
+        return tag;
+    }
+
+    static void recordFree(std::size_t bytes, const char* tag)
+    {
+        State& state = instance();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        MemoryTrackerStatistics& stats = state.stats;
+        ++stats.freeCount;
+        stats.liveBytes -= bytes;
+        stats.tags[tag].liveBytes -= bytes;
+    }
+
+    static MemoryTrackerStatistics snapshot()
+    {
+        State& state = instance();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        return state.stats;
+    }
+
+    // 清空累计计数与直方图，峰值重置为当前使用量，当前仍在使用的字节数保持不变
+    static void reset()
+    {
+        State& state = instance();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        MemoryTrackerStatistics& stats = state.stats;
+        stats.allocateCount = 0;
+        stats.freeCount = 0;
+        stats.allocatedBytes = 0;
+        stats.peakBytes = stats.liveBytes;
+        stats.histogram.fill(0);
+        for (auto it = stats.tags.begin(); it != stats.tags.end();)
+        {
+            if (it->second.liveBytes == 0)
+            {
+                it = stats.tags.erase(it);
+            }
+            else
+            {
+                it->second.allocateCount = 0;
+                it->second.allocatedBytes = 0;
+                ++it;
+            }
+        }
+    }
+
+private:
+    friend class AllocationTagScope;
+
+    struct State
+    {
+        std::mutex mutex;
+        MemoryTrackerStatistics stats;
+    };
+
+    static State& instance()
+    {
+        static State state;
+        return state;
+    }
+
+    static const char*& currentTag()
+    {
+        thread_local const char* tag = nullptr;
+        return tag;
+    }
+};
+
+// 在作用域内为当前线程的分配指定归属标签（比如操作名），可以嵌套，内层优先
+// tag必须在被跟踪的内存释放之前一直有效，通常使用字符串字面量
+class AllocationTagScope
+{
+public:
+    explicit AllocationTagScope(const char* tag)
+        : m_previous(MemoryTracker::currentTag())
+    {
+        MemoryTracker::currentTag() = tag;
+    }
+    ~AllocationTagScope()
+    {
+        MemoryTracker::currentTag() = m_previous;
+    }
+    AllocationTagScope(const AllocationTagScope&) = delete;
+    AllocationTagScope& operator=(const AllocationTagScope&) = delete;
+
+private:
+    const char* m_previous;
+};
+
+} // namespace MetaNN
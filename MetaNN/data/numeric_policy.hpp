@@ -0,0 +1,56 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/float16.hpp>
+#include <type_traits>
+#include <policy/policy_container.hpp>
+#include <policy/policy_selector.hpp>
+#include <policy/policy_macro_begin.hpp>
+
+namespace MetaNN
+{
+
+// 数值计算相关的策略
+struct NumericPolicy
+{
+    using MajorClass = NumericPolicy;
+
+    // 求和类运算（矩阵乘法、折叠、softmax及其导数）中间结果的累加类型，void表示使用元素类型本身
+    // 累加完成后再转换为元素类型写入结果，16位浮点元素默认在float中累加，避免逐次舍入造成的精度损失
+    struct AccumulateTypeCategory;
+    using Accumulate = void;
+};
+
+TypePolicyTemplate(PAccumulateIs, NumericPolicy, Accumulate);
+
+// 为特定元素类型与设备指定数值策略，用法同DataMemoryPolicy_，比如令float在double中累加：
+//      template<> struct DataNumericPolicy_<float, DeviceTags::CPU> { using type = PolicyContainer<PAccumulateIs<double>>; };
+template<typename TElem, typename TDevice>
+struct DataNumericPolicy_
+{
+    using type = PolicyContainer<>;
+};
+
+template<>
+struct DataNumericPolicy_<Float16, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PAccumulateIs<float>>;
+};
+
+template<>
+struct DataNumericPolicy_<BFloat16, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PAccumulateIs<float>>;
+};
+
+template<typename TElem, typename TDevice>
+using DataNumericPolicy = PolicySelect<NumericPolicy, typename DataNumericPolicy_<TElem, TDevice>::type>;
+
+// 元素类型与设备对应的累加类型
+template<typename TElem, typename TDevice>
+using AccumulateType = std::conditional_t<std::is_void_v<typename DataNumericPolicy<TElem, TDevice>::Accumulate>,
+                                          TElem, typename DataNumericPolicy<TElem, TDevice>::Accumulate>;
+
+} // namespace MetaNN
+
+#include <policy/policy_macro_end.hpp>
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/memory_block.hpp>
+#include <mutex>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace MetaNN
+{
+
+// 内存池的统计信息
+struct PoolStatistics
+{
+    std::size_t allocateCount = 0;  // 分配次数
+    std::size_t hitCount = 0;       // 从空闲链表中直接取得内存块的次数
+    std::size_t missCount = 0;      // 空闲链表为空，需要向堆申请的次数
+    std::size_t cachedBlocks = 0;   // 当前缓存在池中的空闲块数量
+    std::size_t cachedBytes = 0;    // 当前缓存在池中的空闲块总字节数
+
+    double hitRate() const
+    {
+        return allocateCount == 0 ? 0.0 : static_cast<double>(hitCount) / allocateCount;
+    }
+};
+
+template<typename TDevice>
+class PoolAllocator;
+
+// CPU内存池：按大小类别维护空闲链表，内存块释放时归还给池，而不是还给堆
+// 大小类别：不超过MinBlockSize的都按MinBlockSize分配，更大的在每个2的幂次区间中等分为4个类别，浪费不超过25%
+// 不同对齐的内存块分别缓存，互不复用
+// 线程安全：所有操作都由一个互斥量保护
+template<>
+class PoolAllocator<DeviceTags::CPU>
+{
+public:
+    static constexpr std::size_t MinBlockSize = 64;
+
+    // 空闲链表的键：大小类别（即内存块字节数）与对齐
+    using BlockKey = std::pair<std::size_t, std::size_t>;
+
+    static RawMemory allocate(std::size_t bytes, std::size_t alignment)
+    {
+        BlockKey key{sizeClass(bytes), alignment};
+        return RawMemory{acquire(key), key.first, key.second, nullptr, [](const RawMemory& raw) {
+            release(raw.ptr, BlockKey{raw.size, raw.alignment});
+        }};
+    }
+
+    // 将池中缓存的空闲内存块全部归还给堆，正在使用的内存块不受影响
+    static void trim()
+    {
+        Pool& pool = instance();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.clear();
+        pool.stats.cachedBlocks = 0;
+        pool.stats.cachedBytes = 0;
+    }
+
+    static PoolStatistics statistics()
+    {
+        Pool& pool = instance();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        return pool.stats;
+    }
+
+    // 清空计数，不影响缓存信息
+    static void resetStatistics()
+    {
+        Pool& pool = instance();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.stats.allocateCount = 0;
+        pool.stats.hitCount = 0;
+        pool.stats.missCount = 0;
+    }
+
+    // 计算字节数对应的大小类别，即实际分配的内存块大小
+    static std::size_t sizeClass(std::size_t bytes)
+    {
+        if (bytes <= MinBlockSize)
+        {
+            return MinBlockSize;
+        }
+        std::size_t shift = std::bit_width(bytes - 1) - 3;
+        return (((bytes - 1) >> shift) + 1) << shift;
+    }
+
+    // 原始内存块接口，供构建于内存池之上的分配器使用，key.first必须是sizeClass的结果
+    static void* acquire(const BlockKey& key)
+    {
+        Pool& pool = instance();
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            ++pool.stats.allocateCount;
+            auto it = pool.freeLists.find(key);
+            if (it != pool.freeLists.end() && !it->second.empty())
+            {
+                void* p = it->second.back();
+                it->second.pop_back();
+                ++pool.stats.hitCount;
+                --pool.stats.cachedBlocks;
+                pool.stats.cachedBytes -= key.first;
+                return p;
+            }
+            ++pool.stats.missCount;
+        }
+        return ::operator new(key.first, std::align_val_t{key.second});
+    }
+
+    static void release(void* p, const BlockKey& key)
+    {
+        Pool& pool = instance();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.freeLists[key].push_back(p);
+        ++pool.stats.cachedBlocks;
+        pool.stats.cachedBytes += key.first;
+    }
+
+private:
+    struct Pool
+    {
+        std::mutex mutex;
+        std::map<BlockKey, std::vector<void*>> freeLists;
+        PoolStatistics stats;
+
+        void clear()
+        {
+            for (auto& [key, freeList] : freeLists)
+            {
+                for (void* p : freeList)
+                {
+                    ::operator delete(p, std::align_val_t{key.second});
+                }
+            }
+            freeLists.clear();
+        }
+        ~Pool()
+        {
+            clear();
+        }
+    };
+
+    // 首次分配时构造，在所有通过它分配的静态对象之后析构
+    static Pool& instance()
+    {
+        static Pool pool;
+        return pool;
+    }
+};
+
+} // namespace MetaNN
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/pool_allocator.hpp>
+#include <data/memory_block.hpp>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+namespace MetaNN
+{
+
+// 线程缓存的统计信息，所有线程汇总
+struct ThreadCacheStatistics
+{
+    std::size_t allocateCount = 0;      // 分配次数
+    std::size_t localHitCount = 0;      // 直接从本线程缓存取得内存块的次数
+    std::size_t remoteFreeCount = 0;    // 在其他线程释放、被送回所属线程的内存块数量
+    std::size_t threadCacheCount = 0;   // 已创建的线程缓存数量
+
+    double hitRate() const
+    {
+        return allocateCount == 0 ? 0.0 : static_cast<double>(localHitCount) / allocateCount;
+    }
+};
+
+template<typename TDevice>
+class ThreadCacheAllocator;
+
+// 位于内存池之前的线程缓存：
+// - 每个线程拥有一个缓存，分配与同线程释放只访问本线程的空闲链表，不加锁
+// - 内存块记录其所属的缓存，在其他线程释放时，通过无锁栈送回所属缓存，由所属线程在下次分配时取回
+// - 本线程缓存未命中时从内存池取，每个大小类别缓存超过MaxCachedBlocks时多余的内存块还给内存池
+// - 线程退出时其缓存中的内存块还给内存池，缓存对象本身保留，由之后创建的线程复用，之后送回该缓存的内存块在复用时取回
+template<>
+class ThreadCacheAllocator<DeviceTags::CPU>
+{
+    using Pool = PoolAllocator<DeviceTags::CPU>;
+    using BlockKey = Pool::BlockKey;
+
+    // 送回所属缓存的内存块，链表节点直接存放在被释放的内存块中（内存块不小于Pool::MinBlockSize）
+    struct RemoteBlock
+    {
+        RemoteBlock* next;
+        BlockKey key;
+    };
+    static_assert(sizeof(RemoteBlock) <= Pool::MinBlockSize);
+
+    // 单写者计数器：只由所属线程修改，其他线程可以读取
+    struct Counter
+    {
+        std::atomic<std::size_t> value{0};
+        void increase()
+        {
+            value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        std::size_t get() const
+        {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    struct Cache
+    {
+        std::map<BlockKey, std::vector<void*>> freeLists;  // 只由所属线程访问
+        std::atomic<RemoteBlock*> remoteHead{nullptr};      // 其他线程送回的内存块
+        bool owned = false;                                 // 受Registry::mutex保护
+        Counter allocateCount;
+        Counter localHitCount;
+        Counter remoteFreeCount;
+
+        void pushRemote(void* p, const BlockKey& key)
+        {
+            RemoteBlock* block = static_cast<RemoteBlock*>(p);
+            block->key = key;
+            block->next = remoteHead.load(std::memory_order_relaxed);
+            while (!remoteHead.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+        // 取回其他线程送回的内存块
+        void collectRemote()
+        {
+            RemoteBlock* block = remoteHead.exchange(nullptr, std::memory_order_acquire);
+            while (block)
+            {
+                RemoteBlock* next = block->next;
+                BlockKey key = block->key;
+                push(block, key);
+                remoteFreeCount.increase();
+                block = next;
+            }
+        }
+        void push(void* p, const BlockKey& key)
+        {
+            auto& freeList = freeLists[key];
+            if (freeList.size() < MaxCachedBlocks)
+            {
+                freeList.push_back(p);
+            }
+            else
+            {
+                Pool::release(p, key);
+            }
+        }
+        // 将所有缓存的内存块还给内存池
+        void flush()
+        {
+            collectRemote();
+            for (auto& [key, freeList] : freeLists)
+            {
+                for (void* p : freeList)
+                {
+                    Pool::release(p, key);
+                }
+            }
+            freeLists.clear();
+        }
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Cache>> caches;
+
+        Registry()
+        {
+            Pool::statistics(); // 确保内存池先于注册表构造，从而后于注册表析构
+        }
+        ~Registry()
+        {
+            for (auto& cache : caches)
+            {
+                cache->flush();
+            }
+        }
+    };
+
+    static Registry& registry()
+    {
+        static Registry reg;
+        return reg;
+    }
+
+    // 线程退出时放弃所属的缓存
+    struct LocalHolder
+    {
+        Cache* cache = nullptr;
+        ~LocalHolder()
+        {
+            if (cache)
+            {
+                Cache* released = cache;
+                localCacheRef() = nullptr;
+                cache = nullptr;
+                released->flush();
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                released->owned = false;
+            }
+        }
+    };
+
+    static Cache*& localCacheRef()
+    {
+        thread_local Cache* cache = nullptr;
+        return cache;
+    }
+
+    // 当前线程的缓存，首次调用时复用已退出线程的缓存或者新建一个
+    static Cache* localCache()
+    {
+        Cache*& cache = localCacheRef();
+        if (!cache)
+        {
+            thread_local LocalHolder holder;
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            auto it = std::find_if(reg.caches.begin(), reg.caches.end(), [](const auto& c) { return !c->owned; });
+            if (it == reg.caches.end())
+            {
+                reg.caches.push_back(std::make_unique<Cache>());
+                it = reg.caches.end() - 1;
+            }
+            (*it)->owned = true;
+            cache = it->get();
+            holder.cache = cache;
+        }
+        return cache;
+    }
+
+public:
+    // 每个大小类别在一个线程中最多缓存的内存块数量
+    static constexpr std::size_t MaxCachedBlocks = 64;
+
+    static RawMemory allocate(std::size_t bytes, std::size_t alignment)
+    {
+        BlockKey key{Pool::sizeClass(bytes), alignment};
+        Cache* owner = localCache();
+        return RawMemory{acquire(owner, key), key.first, key.second, owner, [](const RawMemory& raw) {
+            release(raw.ptr, static_cast<Cache*>(raw.context), BlockKey{raw.size, raw.alignment});
+        }};
+    }
+
+    // 将当前线程缓存的内存块还给内存池，并整理内存池，其他线程的缓存不受影响
+    static void trim()
+    {
+        localCache()->flush();
+        Pool::trim();
+    }
+
+    static ThreadCacheStatistics statistics()
+    {
+        ThreadCacheStatistics stats;
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& cache : reg.caches)
+        {
+            stats.allocateCount += cache->allocateCount.get();
+            stats.localHitCount += cache->localHitCount.get();
+            stats.remoteFreeCount += cache->remoteFreeCount.get();
+        }
+        stats.threadCacheCount = reg.caches.size();
+        return stats;
+    }
+
+private:
+    static void* acquire(Cache* cache, const BlockKey& key)
+    {
+        cache->allocateCount.increase();
+        auto& freeList = cache->freeLists[key];
+        if (freeList.empty())
+        {
+            cache->collectRemote();
+        }
+        if (!freeList.empty())
+        {
+            void* p = freeList.back();
+            freeList.pop_back();
+            cache->localHitCount.increase();
+            return p;
+        }
+        return Pool::acquire(key);
+    }
+
+    static void release(void* p, Cache* owner, const BlockKey& key)
+    {
+        if (owner == localCacheRef())
+        {
+            owner->push(p, key);
+        }
+        else
+        {
+            owner->pushRemote(p, key);
+        }
+    }
+};
+
+} // namespace MetaNN
@@ -3,14 +3,30 @@
 #include <data/tags.hpp>
 #include <type_traits>
 #include <concepts>
+#include <cstddef>
 
 namespace MetaNN
 {
 
+// 编译期未知的维度，Matrix的行列数默认为该值，即运行期确定行列数
+constexpr std::size_t DynamicExtent = static_cast<std::size_t>(-1);
+
 // 前向声明
 template<typename TElem, typename TDevice> class Scalar;
-template<typename TElem, typename TDevice> class Matrix;
+template<typename TElem, typename TDevice = DeviceTags::CPU, std::size_t Rows = DynamicExtent, std::size_t Cols = DynamicExtent>
+class Matrix;
 template<typename TElem, typename TDevice, typename TCategory> class Batch;
+template<typename TElem, typename TDevice = DeviceTags::CPU, std::size_t TileSize = 64>
+class TiledMatrix;
+template<typename TElem, typename TDevice = DeviceTags::CPU>
+class SparseMatrix;
+template<typename TElem, typename TDevice = DeviceTags::CPU>
+class BatchSparseMatrix;
+template<typename TElem, typename TDevice = DeviceTags::CPU>
+class InterleavedBatch;
+template<typename TElem, typename TDevice = DeviceTags::CPU>
+class RaggedBatch;
+template<typename TData> class Array;
 
 // 主体类型
 template<typename TCategory, typename TElem, typename TDevice>
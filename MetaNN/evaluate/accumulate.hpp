@@ -0,0 +1,62 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/numeric_policy.hpp>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+
+namespace MetaNN
+{
+
+// 按行累加：累加类型（见numeric_policy.hpp）与元素类型相同时直接在结果行上累加
+// 否则在累加类型的临时行上累加，一行完成后再舍入为元素类型写回结果行
+template<typename TElem>
+class RowAccumulator
+{
+public:
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    static constexpr bool InPlace = std::is_same_v<AccType, TElem>;
+
+    explicit RowAccumulator(std::size_t colNum)
+        : m_buffer(InPlace ? 0 : colNum)
+        , m_colNum(colNum)
+    {
+    }
+
+    // 开始累加结果中以pDest开始的一行，返回清零后的累加行
+    AccType* begin(TElem* pDest)
+    {
+        m_pDest = pDest;
+        AccType* pAcc;
+        if constexpr (InPlace)
+        {
+            pAcc = pDest;
+        }
+        else
+        {
+            pAcc = m_buffer.data();
+        }
+        std::fill(pAcc, pAcc + m_colNum, AccType{});
+        return pAcc;
+    }
+    // 当前行累加完成
+    void finish()
+    {
+        if constexpr (!InPlace)
+        {
+            for (std::size_t j = 0; j < m_colNum; ++j)
+            {
+                m_pDest[j] = static_cast<TElem>(m_buffer[j]);
+            }
+        }
+    }
+
+private:
+    std::vector<AccType> m_buffer;
+    std::size_t m_colNum;
+    TElem* m_pDest = nullptr;
+};
+
+} // namespace MetaNN
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <evaluate/evaluate.hpp>
+#include <data/matrix/trivial_matrix.hpp>
+#include <data/matrix/zero_matrix.hpp>
+#include <data/matrix/one_hot_vector.hpp>
+#include <data/batch/batch_one_hot_vector.hpp>
+#include <data/batch/duplicate.hpp>
+#include <data/batch/batch.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace MetaNN
+{
+
+// 平凡矩阵、全零矩阵、独热向量、独热向量列表与重复列表的求值
+// 求值结果为稠密矩阵，由数据自身缓存（见materialize()），同一个对象及其拷贝只生成一次
+// 能够直接利用其结构的运算在求值情形中按原始类型识别这些数据，不调用evaluate：
+//      逐元素运算以广播视图参与计算（见elementwise.hpp）
+//      矩阵乘法按常量、全零与取行计算（见dot.hpp）
+// 其他运算使用缓存的稠密矩阵，例如转置得到缓存矩阵的转置视图，重复求值时不再复制元素
+
+template<typename TElem, typename TDevice, typename TScalar>
+struct DataEvaluator_<TrivialMatrix<TElem, TDevice, TScalar>>
+{
+    static auto eval(const TrivialMatrix<TElem, TDevice, TScalar>& data)
+    {
+        return data.materialize();
+    }
+};
+
+template<typename TElem, typename TDevice>
+struct DataEvaluator_<ZeroMatrix<TElem, TDevice>>
+{
+    static auto eval(const ZeroMatrix<TElem, TDevice>& data)
+    {
+        return data.materialize();
+    }
+};
+
+template<typename TElem, typename TDevice>
+struct DataEvaluator_<OneHotVector<TElem, TDevice>>
+{
+    static auto eval(const OneHotVector<TElem, TDevice>& data)
+    {
+        return data.materialize();
+    }
+};
+
+template<typename TElem, typename TDevice>
+struct DataEvaluator_<BatchOneHotVector<TElem, TDevice>>
+{
+    static auto eval(const BatchOneHotVector<TElem, TDevice>& data)
+    {
+        return data.materialize();
+    }
+};
+
+// 重复列表：矩阵的重复列表求值为矩阵间隔为0的矩阵列表，所有矩阵共享被重复矩阵的存储，不复制batchNum份
+// 运算可以通过BatchMatrixView::isShared()识别，对共享的操作数只做一次预处理（见dot.hpp）
+template<typename TData>
+    requires MatrixC<TData> && requires(const TData& data) { evaluate(data).view(); }
+struct DataEvaluator_<Duplicate<TData>>
+{
+    static auto eval(const Duplicate<TData>& data)
+    {
+        using ElementType = typename TData::ElementType;
+        using ResType = Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix>;
+        const auto elem = evaluate(data.element());
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(elem)>, Matrix<ElementType, DeviceTags::CPU>>)
+        {
+            return ResType::duplicate(elem, data.batchNum());
+        }
+        else
+        {
+            // 编译期形状的矩阵等没有可共享的动态存储，先复制一份
+            Matrix<ElementType, DeviceTags::CPU> mat(elem.rowNum(), elem.colNum());
+            const auto src = elem.view();
+            const auto dest = mat.mutableView();
+            for (std::size_t i = 0; i < mat.rowNum(); ++i)
+            {
+                for (std::size_t j = 0; j < mat.colNum(); ++j)
+                {
+                    dest(i, j) = src(i, j);
+                }
+            }
+            return ResType::duplicate(mat, data.batchNum());
+        }
+    }
+};
+
+// 标量的重复列表：标量列表没有间隔，直接填充
+template<typename TData>
+    requires ScalarC<TData> && requires(const TData& data) { evaluate(data).value(); }
+struct DataEvaluator_<Duplicate<TData>>
+{
+    static auto eval(const Duplicate<TData>& data)
+    {
+        using ElementType = typename TData::ElementType;
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Scalar> res(data.batchNum());
+        const auto dest = res.mutableView();
+        std::fill(dest.begin(), dest.end(), static_cast<ElementType>(evaluate(data.element()).value()));
+        return res;
+    }
+};
+
+// 所有元素都相同的矩阵：平凡矩阵与全零矩阵
+template<typename T>
+struct IsBroadcastMatrix_ : std::false_type {};
+
+template<typename TElem, typename TDevice, typename TScalar>
+struct IsBroadcastMatrix_<TrivialMatrix<TElem, TDevice, TScalar>> : std::true_type {};
+
+template<typename TElem, typename TDevice>
+struct IsBroadcastMatrix_<ZeroMatrix<TElem, TDevice>> : std::true_type {};
+
+template<typename T>
+concept BroadcastMatrixC = IsBroadcastMatrix_<std::remove_cvref_t<T>>::value;
+
+template<typename T>
+struct IsZeroMatrix_ : std::false_type {};
+
+template<typename TElem, typename TDevice>
+struct IsZeroMatrix_<ZeroMatrix<TElem, TDevice>> : std::true_type {};
+
+template<typename T>
+concept ZeroMatrixC = IsZeroMatrix_<std::remove_cvref_t<T>>::value;
+
+template<typename T>
+struct IsOneHotVector_ : std::false_type {};
+
+template<typename TElem, typename TDevice>
+struct IsOneHotVector_<OneHotVector<TElem, TDevice>> : std::true_type {};
+
+template<typename T>
+concept OneHotVectorC = IsOneHotVector_<std::remove_cvref_t<T>>::value;
+
+namespace NsEvaluate
+{
+// 逐元素运算的操作数：所有元素都相同的矩阵保持原样（通过广播视图访问），其他数据求值
+template<typename T>
+auto elementSource(const T& data)
+{
+    if constexpr (BroadcastMatrixC<T>)
+    {
+        return data;
+    }
+    else
+    {
+        return evaluate(data);
+    }
+}
+
+// 平凡矩阵（全零矩阵）的重复列表
+template<typename T>
+concept DuplicateBroadcastC = DuplicateC<T> && BroadcastMatrixC<decltype(std::declval<const T&>().element())>;
+
+// 逐元素运算的矩阵列表操作数：平凡矩阵（全零矩阵）的重复列表保持原样，每个矩阵都以同一个广播视图参与计算
+template<typename T>
+auto batchElementSource(const T& data)
+{
+    if constexpr (DuplicateBroadcastC<T>)
+    {
+        return data;
+    }
+    else
+    {
+        return evaluate(data);
+    }
+}
+
+// batchElementSource得到的操作数中第batchId个矩阵的视图
+template<typename T>
+auto batchElementView(const T& data, std::size_t batchId)
+{
+    if constexpr (DuplicateBroadcastC<T>)
+    {
+        return data.element().view();
+    }
+    else
+    {
+        return data.view()[batchId];
+    }
+}
+} // namespace NsEvaluate
+
+} // namespace MetaNN
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <evaluate/evaluate.hpp>
+#include <evaluate/broadcast.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/fixed_matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <data/batch/interleaved_batch.hpp>
+#include <data/batch/ragged_batch.hpp>
+#include <facility/unroll.hpp>
+#include <cassert>
+
+namespace MetaNN
+{
+
+// 逐元素运算的通用求值情形，运算本身由函数对象TFunc给出，TFunc对操作数对应位置的元素进行计算
+// CaseFixedElementwise: 所有操作数求值后都是编译期形状的矩阵，完全展开计算，结果也是编译期形状的矩阵
+// CaseElementwise:      所有操作数都是矩阵或者都是矩阵列表，并且求值后可以通过view()批量访问
+//                       平凡矩阵与全零矩阵（及其重复列表）不求值，以广播视图参与计算，不生成稠密矩阵
+//                       矩阵的重复列表求值为矩阵间隔为0的列表，每个矩阵都访问同一块存储
+//                       所有操作数求值后都是批次交错存储的矩阵列表时，逐组通道沿批次方向计算，结果也是批次交错存储
+//                       变长矩阵列表（可以与平凡矩阵的重复列表一同）在所有行组成的矩阵上计算，各变长列表的分段必须相同
+
+// 求值后可以批量访问的数据
+template<typename T>
+concept ViewableC = requires(const T& data)
+{
+    data.view();
+};
+
+namespace NsEvaluate
+{
+
+// 行内连续时第rowId行的按下标访问方式：一般视图为行首指针，广播视图为总是返回同一个值的对象
+template<typename TElem>
+auto rowAccess(const MatrixView<TElem>& view, std::size_t rowId)
+{
+    return view.row(rowId).data();
+}
+
+template<typename TElem>
+auto rowAccess(const BroadcastView<TElem>& view, std::size_t rowId)
+{
+    return view.row(rowId);
+}
+
+// 对一组形状相同的视图逐元素计算，结果写入dest
+// 操作数可以是广播视图，此时内层循环中对应的操作数是常量，不需要读取内存
+template<typename TElem, typename TFunc, typename... TViews>
+void transformViews(const MatrixView<TElem>& dest, const TFunc& func, const TViews&... src)
+{
+    std::size_t rowNum = dest.rowNum();
+    std::size_t colNum = dest.colNum();
+    assert((true && ... && (src.rowNum() == rowNum && src.colNum() == colNum)));
+    if ((dest.isRowContiguous() && ... && src.isRowContiguous()))
+    {
+        // 行内连续：内层是简单的连续循环，便于向量化
+        for (std::size_t i = 0; i < rowNum; ++i)
+        {
+            TElem* pDest = dest.row(i).data();
+            [&](const auto... pSrc) {
+                for (std::size_t j = 0; j < colNum; ++j)
+                {
+                    pDest[j] = func(pSrc[j]...);
+                }
+            }(rowAccess(src, i)...);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < rowNum; ++i)
+        {
+            for (std::size_t j = 0; j < colNum; ++j)
+            {
+                dest(i, j) = func(src(i, j)...);
+            }
+        }
+    }
+}
+
+template<typename TFunc, typename THead, typename... TRemain>
+auto transformFixed(const TFunc& func, const THead& head, const TRemain&... remain)
+{
+    static_assert((true && ... && (THead::RowNum == TRemain::RowNum && THead::ColNum == TRemain::ColNum)),
+                  "Matrix shape mismatch");
+    using ElementType = typename THead::ElementType;
+    Matrix<ElementType, DeviceTags::CPU, THead::RowNum, THead::ColNum> res;
+    auto& dest = res.mutableElements();
+    unrollFor<THead::Size>([&](auto i) {
+        dest[i] = func(head.elements()[i], remain.elements()[i]...);
+    });
+    return res;
+}
+
+template<typename TFunc, typename THead, typename... TRemain>
+auto transformMatrix(const TFunc& func, const THead& head, const TRemain&... remain)
+{
+    using ElementType = typename THead::ElementType;
+    Matrix<ElementType, DeviceTags::CPU> res(head.rowNum(), head.colNum());
+    transformViews(res.mutableView(), func, head.view(), remain.view()...);
+    return res;
+}
+
+template<typename TFunc, typename THead, typename... TRemain>
+auto transformBatchMatrix(const TFunc& func, const THead& head, const TRemain&... remain)
+{
+    assert((true && ... && (head.batchNum() == remain.batchNum())));
+    using ElementType = typename THead::ElementType;
+    Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(head.batchNum(), head.rowNum(), head.colNum());
+    auto dest = res.mutableView();
+    for (std::size_t b = 0; b < head.batchNum(); ++b)
+    {
+        transformViews(dest[b], func, batchElementView(head, b), batchElementView(remain, b)...);
+    }
+    return res;
+}
+
+// 批次交错存储的矩阵列表：各操作数形状相同时布局也相同，对每组通道（所有矩阵的同一位置）做连续的简单循环
+template<typename TFunc, typename THead, typename... TRemain>
+auto transformInterleaved(const TFunc& func, const THead& head, const TRemain&... remain)
+{
+    assert((true && ... && (head.batchNum() == remain.batchNum() && head.rowNum() == remain.rowNum() &&
+                            head.colNum() == remain.colNum())));
+    using ElementType = typename THead::ElementType;
+    InterleavedBatch<ElementType, DeviceTags::CPU> res(head.batchNum(), head.rowNum(), head.colNum());
+    const std::size_t groupNum = head.rowNum() * head.colNum();
+    const std::size_t batchNum = head.batchNum();
+    const std::size_t laneLen = res.laneLen();
+    ElementType* pDest = res.mutableView().data();
+    [&](const auto*... pSrc) {
+        for (std::size_t g = 0; g < groupNum; ++g)
+        {
+            const std::size_t offset = g * laneLen;
+            for (std::size_t b = 0; b < batchNum; ++b)
+            {
+                pDest[offset + b] = func(pSrc[offset + b]...);
+            }
+        }
+    }(head.view().data(), remain.view().data()...);
+    return res;
+}
+
+// 变长矩阵列表的操作数：变长列表求值，平凡矩阵（全零矩阵）的重复列表保持原样
+template<typename T>
+auto raggedElementSource(const T& data)
+{
+    if constexpr (DuplicateBroadcastC<T>)
+    {
+        return data;
+    }
+    else
+    {
+        return evaluate(data);
+    }
+}
+
+// 操作数中所有行组成的矩阵的视图，重复列表为总行数与shape相同的广播视图
+template<typename T, typename TShape>
+auto raggedElementView(const T& data, const TShape& shape)
+{
+    if constexpr (DuplicateBroadcastC<T>)
+    {
+        using ElementType = typename T::ElementType;
+        return BroadcastView<ElementType>(data.element().value(), shape.totalRowNum(), shape.colNum());
+    }
+    else
+    {
+        assert(data.sameSegments(shape) && data.colNum() == shape.colNum());
+        return data.packedView();
+    }
+}
+
+// 第一个变长列表操作数，决定结果的分段
+template<typename THead, typename... TRemain>
+const auto& raggedShape(const THead& head, const TRemain&... remain)
+{
+    if constexpr (RaggedBatchC<THead>)
+    {
+        return head;
+    }
+    else
+    {
+        return raggedShape(remain...);
+    }
+}
+
+template<typename TFunc, typename... TOperands>
+auto transformRagged(const TFunc& func, const TOperands&... operands)
+{
+    const auto& shape = raggedShape(operands...);
+    auto res = std::remove_cvref_t<decltype(shape)>::withSegmentsOf(shape, shape.colNum());
+    transformViews(res.mutablePackedView(), func, raggedElementView(operands, shape)...);
+    return res;
+}
+
+} // namespace NsEvaluate
+
+template<typename TFunc>
+struct CaseFixedElementwise
+{
+    template<typename... TOperands>
+        requires (true && ... && FixedMatrixC<EvalResult<TOperands>>)
+    static auto eval(const TOperands&... operands)
+    {
+        return NsEvaluate::transformFixed(TFunc{}, evaluate(operands)...);
+    }
+};
+
+template<typename TFunc>
+struct CaseElementwise
+{
+    template<typename... TOperands>
+        requires (true && ... && (MatrixC<TOperands> && ViewableC<EvalResult<TOperands>>))
+    static auto eval(const TOperands&... operands)
+    {
+        return NsEvaluate::transformMatrix(TFunc{}, NsEvaluate::elementSource(operands)...);
+    }
+
+    template<typename... TOperands>
+        requires (true && ... && (BatchMatrixC<TOperands> && ViewableC<EvalResult<TOperands>>)) &&
+                 (!(true && ... && InterleavedBatchC<EvalResult<TOperands>>))
+    static auto eval(const TOperands&... operands)
+    {
+        return NsEvaluate::transformBatchMatrix(TFunc{}, NsEvaluate::batchElementSource(operands)...);
+    }
+
+    template<typename... TOperands>
+        requires (true && ... && InterleavedBatchC<EvalResult<TOperands>>)
+    static auto eval(const TOperands&... operands)
+    {
+        return NsEvaluate::transformInterleaved(TFunc{}, evaluate(operands)...);
+    }
+
+    template<typename... TOperands>
+        requires (true && ... && (RaggedBatchC<EvalResult<TOperands>> || NsEvaluate::DuplicateBroadcastC<TOperands>)) &&
+                 (false || ... || RaggedBatchC<EvalResult<TOperands>>)
+    static auto eval(const TOperands&... operands)
+    {
+        return NsEvaluate::transformRagged(TFunc{}, NsEvaluate::raggedElementSource(operands)...);
+    }
+};
+
+} // namespace MetaNN
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <data/tags.hpp>
+#include <data/traits.hpp>
+#include <operator/traits.hpp>
+#include <operator/operators.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace MetaNN
+{
+
+// 求值：将数据或者运算表达式计算为可以直接访问元素的数据
+// 主体类型（Scalar、Matrix、Batch）、分块矩阵、批次交错存储与变长的矩阵列表求值结果为其自身（浅拷贝，共享存储）
+// 可变列表（Array）求值为连续存储的Batch，稀疏矩阵（列表）求值为稠密矩阵（列表）
+// 运算表达式依次尝试OpSeq_为该运算指定的求值情形（OpSeqContainer），使用第一个可行的情形求值
+// 求值情形是提供静态函数eval的类，通过对eval的约束声明自己适用的操作数类型，操作数按原始类型传入，由情形决定如何求值
+// 其他数据类型通过特化DataEvaluator_提供求值方法
+template<typename TData>
+struct DataEvaluator_;
+
+template<typename TData>
+concept EvaluableC = requires(const TData& data)
+{
+    DataEvaluator_<TData>::eval(data);
+};
+
+template<typename TData>
+    requires EvaluableC<TData>
+auto evaluate(const TData& data)
+{
+    return DataEvaluator_<TData>::eval(data);
+}
+
+// 求值结果类型
+template<typename TData>
+using EvalResult = decltype(evaluate(std::declval<const TData&>()));
+
+// 主体类型
+template<typename TElem, typename TDevice>
+struct DataEvaluator_<Scalar<TElem, TDevice>>
+{
+    static auto eval(const Scalar<TElem, TDevice>& data)
+    {
+        return data;
+    }
+};
+
+template<typename TElem, typename TDevice, std::size_t Rows, std::size_t Cols>
+struct DataEvaluator_<Matrix<TElem, TDevice, Rows, Cols>>
+{
+    static auto eval(const Matrix<TElem, TDevice, Rows, Cols>& data)
+    {
+        return data;
+    }
+};
+
+template<typename TElem, typename TDevice, typename TCategory>
+struct DataEvaluator_<Batch<TElem, TDevice, TCategory>>
+{
+    static auto eval(const Batch<TElem, TDevice, TCategory>& data)
+    {
+        return data;
+    }
+};
+
+template<typename TElem, typename TDevice, std::size_t TileSize>
+struct DataEvaluator_<TiledMatrix<TElem, TDevice, TileSize>>
+{
+    static auto eval(const TiledMatrix<TElem, TDevice, TileSize>& data)
+    {
+        return data;
+    }
+};
+
+template<typename TElem, typename TDevice>
+struct DataEvaluator_<InterleavedBatch<TElem, TDevice>>
+{
+    static auto eval(const InterleavedBatch<TElem, TDevice>& data)
+    {
+        return data;
+    }
+};
+
+template<typename TElem, typename TDevice>
+struct DataEvaluator_<RaggedBatch<TElem, TDevice>>
+{
+    static auto eval(const RaggedBatch<TElem, TDevice>& data)
+    {
+        return data;
+    }
+};
+
+// 稀疏矩阵（列表）：求值结果为展开后的稠密矩阵（列表），每次求值都重新展开，不缓存
+// 与稠密矩阵的乘法按原始类型识别，直接使用CSR数据，不调用evaluate（见dot.hpp）；转置、逐元素运算等其他运算使用展开后的稠密矩阵
+template<typename TElem, typename TDevice>
+struct DataEvaluator_<SparseMatrix<TElem, TDevice>>
+{
+    static auto eval(const SparseMatrix<TElem, TDevice>& data)
+    {
+        return makeDense(data);
+    }
+};
+
+template<typename TElem, typename TDevice>
+struct DataEvaluator_<BatchSparseMatrix<TElem, TDevice>>
+{
+    static auto eval(const BatchSparseMatrix<TElem, TDevice>& data)
+    {
+        return makeDense(data);
+    }
+};
+
+// 可变列表：求值结果为收集了全部元素的连续列表，由数组缓存到下一次修改（见Array::materialize()）
+template<typename TData>
+struct DataEvaluator_<Array<TData>>
+{
+    static auto eval(const Array<TData>& data)
+    {
+        return data.materialize();
+    }
+};
+
+// 求值情形列表
+template<typename... TCases>
+struct OpSeqContainer
+{
+};
+
+namespace NsEvaluate
+{
+
+template<typename TOpTag, typename... TOperands>
+auto evalCases(OpSeqContainer<>*, const TOperands&...)
+{
+    static_assert(DependencyFalse<TOpTag>, "No evaluation case available for the operands");
+}
+
+template<typename TOpTag, typename THead, typename... TRemain, typename... TOperands>
+auto evalCases(OpSeqContainer<THead, TRemain...>*, const TOperands&... operands)
+{
+    if constexpr (requires { THead::eval(operands...); })
+    {
+        return THead::eval(operands...);
+    }
+    else
+    {
+        return evalCases<TOpTag>(static_cast<OpSeqContainer<TRemain...>*>(nullptr), operands...);
+    }
+}
+
+template<typename TOpTag, typename... TOperands>
+auto evalOp(const TOperands&... operands)
+{
+    using Cases = typename OpSeq_<TOpTag>::type;
+    return evalCases<TOpTag>(static_cast<Cases*>(nullptr), operands...);
+}
+
+} // namespace NsEvaluate
+
+// 运算表达式
+template<typename TOpTag, typename TData>
+struct DataEvaluator_<UnaryOp<TOpTag, TData>>
+{
+    static auto eval(const UnaryOp<TOpTag, TData>& op)
+    {
+        return NsEvaluate::evalOp<TOpTag>(op.operand());
+    }
+};
+
+template<typename TOpTag, typename TData1, typename TData2>
+struct DataEvaluator_<BinaryOp<TOpTag, TData1, TData2>>
+{
+    static auto eval(const BinaryOp<TOpTag, TData1, TData2>& op)
+    {
+        return NsEvaluate::evalOp<TOpTag>(op.operand1(), op.operand2());
+    }
+};
+
+template<typename TOpTag, typename TData1, typename TData2, typename TData3>
+struct DataEvaluator_<TernaryOp<TOpTag, TData1, TData2, TData3>>
+{
+    static auto eval(const TernaryOp<TOpTag, TData1, TData2, TData3>& op)
+    {
+        return NsEvaluate::evalOp<TOpTag>(op.operand1(), op.operand2(), op.operand3());
+    }
+};
+
+} // namespace MetaNN
@@ -17,26 +17,29 @@ void dataCopy(const Matrix<TElem, DeviceTags::CPU>& src, Matrix<TElem, DeviceTag
     {
         throw std::runtime_error("Error in dataCopy: matrix dimension mismatch!");
     }
-    const auto memSrc = lowerAccess(src);
-    auto memDest = lowerAccess(dest);
+    const auto viewSrc = src.view();
+    auto viewDest = dest.mutableView();
 
-    std::size_t srcRowLen = memSrc.rowLen();
-    std::size_t destRowLen = memDest.rowLen();
-
-    const TElem* pSrc = memSrc.rawMemory();
-    TElem* pDest = memDest.mutableRawMemory();
-
-    if (srcRowLen == colNum && destRowLen == colNum)
+    if (viewSrc.isContiguous() && viewDest.isContiguous())
+    {
+        std::ranges::copy(viewSrc.elements(), viewDest.data());
+    }
+    else if (viewSrc.isRowContiguous() && viewDest.isRowContiguous())
     {
-        std::copy(pSrc, pSrc + rowNum * colNum, pDest);
+        for (std::size_t i = 0; i < rowNum; ++i)
+        {
+            std::ranges::copy(viewSrc.row(i), viewDest.row(i).data());
+        }
     }
     else
     {
+        // 存在转置视图等列不连续的情况，逐个元素复制
         for (std::size_t i = 0; i < rowNum; ++i)
         {
-            std::copy(pSrc, pSrc + colNum, pDest);
-            pDest += destRowLen;
-            pSrc += srcRowLen;
+            for (std::size_t j = 0; j < colNum; ++j)
+            {
+                viewDest(i, j) = viewSrc(i, j);
+            }
         }
     }
 }
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+// 编译期展开的循环：循环次数为编译期常量，循环体被完全展开，下标以std::integral_constant传入
+// 用于编译期确定形状的小矩阵，避免循环控制开销并便于编译器进行寄存器分配与向量化
+
+namespace MetaNN
+{
+
+namespace NsUnroll
+{
+
+template<typename TFunc, std::size_t... Is>
+constexpr void unrollFor(TFunc&& func, std::index_sequence<Is...>)
+{
+    (func(std::integral_constant<std::size_t, Is>{}), ...);
+}
+
+} // namespace NsUnroll
+
+template<std::size_t N, typename TFunc>
+constexpr void unrollFor(TFunc&& func)
+{
+    NsUnroll::unrollFor(std::forward<TFunc>(func), std::make_index_sequence<N>{});
+}
+
+} // namespace MetaNN
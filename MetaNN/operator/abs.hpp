@@ -1,6 +1,7 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
 
 namespace MetaNN
 {
@@ -24,4 +25,23 @@ auto abs(T&& data)
     return OpAbs<T>::eval(std::forward<T>(data));
 }
 
+// 求值：逐元素取绝对值
+namespace NsAbs
+{
+struct ElementFunc
+{
+    template<typename TElem>
+    TElem operator()(TElem a) const
+    {
+        return a < TElem{} ? -a : a;
+    }
+};
+} // namespace NsAbs
+
+template<>
+struct OpSeq_<UnaryOpTags::Abs>
+{
+    using type = OpSeqContainer<CaseFixedElementwise<NsAbs::ElementFunc>, CaseElementwise<NsAbs::ElementFunc>>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
 #include <data/matrix/trivial_matrix.hpp>
 #include <data/batch/duplicate.hpp>
 
@@ -35,8 +36,8 @@ public:
     {
         if constexpr (ScalarC<T1> && MatrixC<T2>)
         {
-            using ElementType = typename T2::ElementType;
-            using DeviceType = typename T2::DeviceType;
+            using ElementType = typename RawT2::ElementType;
+            using DeviceType = typename RawT2::DeviceType;
             auto tmpTrivialMatix = makeTrivialMatrix<ElementType, DeviceType>(data2.rowNum(), data2.colNum(), data1);
             using ResType = BinaryOp<BinaryOpTags::Add, std::remove_cvref_t<decltype(tmpTrivialMatix)>, RawT2>;
             return ResType(std::move(tmpTrivialMatix), std::forward<T2>(data2));
@@ -51,8 +52,8 @@ public:
     {
         if constexpr (ScalarC<T1> && BatchMatrixC<T2>)
         {
-            using ElementType = typename T2::ElementType;
-            using DeviceType = typename T2::DeviceType;
+            using ElementType = typename RawT2::ElementType;
+            using DeviceType = typename RawT2::DeviceType;
             auto tmpTrivialMatrix = makeTrivialMatrix<ElementType, DeviceType>(data2.rowNum(), data2.colNum(), data1);
             auto tmpDuplicateTrivialMatrix = makeDuplicate(data2.batchNum(), std::move(tmpTrivialMatrix));
             using ResType = BinaryOp<BinaryOpTags::Add, std::remove_cvref_t<decltype(tmpDuplicateTrivialMatrix)>, RawT2>;
@@ -71,7 +72,7 @@ public:
 
         if constexpr (MatrixC<T1> && BatchMatrixC<T2>)
         {
-            auto tmpDuplicateMatrix = makeDuplicate(data2.batchNum(), std::move(data1));
+            auto tmpDuplicateMatrix = makeDuplicate(data2.batchNum(), std::forward<T1>(data1));
             using ResType = BinaryOp<BinaryOpTags::Add, std::remove_cvref_t<decltype(tmpDuplicateMatrix)>, RawT2>;
             return ResType(std::move(tmpDuplicateMatrix), std::forward<T2>(data2));
         }
@@ -96,4 +97,23 @@ auto operator+(T1&& data1, T2&& data2)
     return OpAdd<T1, T2>::eval(std::forward<T1>(data1), std::forward<T2>(data2));
 }
 
+// 求值：逐元素相加
+namespace NsAdd
+{
+struct ElementFunc
+{
+    template<typename TElem>
+    TElem operator()(TElem a, TElem b) const
+    {
+        return a + b;
+    }
+};
+} // namespace NsAdd
+
+template<>
+struct OpSeq_<BinaryOpTags::Add>
+{
+    using type = OpSeqContainer<CaseFixedElementwise<NsAdd::ElementFunc>, CaseElementwise<NsAdd::ElementFunc>>;
+};
+
 } // namespace MetaNN
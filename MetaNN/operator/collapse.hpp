@@ -1,6 +1,9 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <evaluate/accumulate.hpp>
+#include <data/matrix/matrix.hpp>
 
 namespace MetaNN
 {
@@ -12,6 +15,32 @@ struct OpCategory_<UnaryOpTags::Collapse, CategoryTags::BatchMatrix>
     using type = CategoryTags::Matrix;
 };
 
+// 结果矩阵的形状与列表中每个矩阵的形状相同
+template<>
+class OpOrganizer<UnaryOpTags::Collapse, CategoryTags::Matrix>
+{
+public:
+    template<BatchMatrixC TData>
+    OpOrganizer(const TData& data)
+        : m_rowNum(data.rowNum())
+        , m_colNum(data.colNum())
+    {
+    }
+
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+
+private:
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+};
+
 template<typename T>
 class OpCollapse
 {
@@ -30,4 +59,57 @@ auto collapse(T&& data) requires BatchMatrixC<T>
     return OpCollapse<T>::eval(std::forward<T>(data));
 }
 
+// 求值：按行累加各个矩阵，在累加类型中求和
+namespace NsCollapse
+{
+struct CaseGeneral
+{
+    template<typename T>
+        requires BatchMatrixC<T> && ViewableC<EvalResult<T>>
+    static auto eval(const T& data)
+    {
+        const auto batch = evaluate(data);
+        using ElementType = typename std::remove_cvref_t<decltype(batch)>::ElementType;
+        using AccType = AccumulateType<ElementType, DeviceTags::CPU>;
+        const std::size_t colNum = batch.colNum();
+
+        Matrix<ElementType, DeviceTags::CPU> res(batch.rowNum(), colNum);
+        const auto src = batch.view();
+        const auto dest = res.mutableView();
+        RowAccumulator<ElementType> accumulator(colNum);
+        for (std::size_t i = 0; i < batch.rowNum(); ++i)
+        {
+            AccType* pAcc = accumulator.begin(dest.row(i).data());
+            for (std::size_t batchId = 0; batchId < batch.batchNum(); ++batchId)
+            {
+                const auto matrix = src[batchId];
+                if (matrix.isRowContiguous())
+                {
+                    const auto* pSrc = matrix.row(i).data();
+                    for (std::size_t j = 0; j < colNum; ++j)
+                    {
+                        pAcc[j] += static_cast<AccType>(pSrc[j]);
+                    }
+                }
+                else
+                {
+                    for (std::size_t j = 0; j < colNum; ++j)
+                    {
+                        pAcc[j] += static_cast<AccType>(matrix(i, j));
+                    }
+                }
+            }
+            accumulator.finish();
+        }
+        return res;
+    }
+};
+} // namespace NsCollapse
+
+template<>
+struct OpSeq_<UnaryOpTags::Collapse>
+{
+    using type = OpSeqContainer<NsCollapse::CaseGeneral>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
@@ -1,6 +1,23 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <operator/quantize.hpp>
+#include <evaluate/elementwise.hpp>
+#include <evaluate/broadcast.hpp>
+#include <evaluate/accumulate.hpp>
+#include <data/matrix/sparse_matrix.hpp>
+#include <data/batch/duplicate.hpp>
+#include <data/batch/batch_sparse_matrix.hpp>
+#include <data/batch/batch_one_hot_vector.hpp>
+#include <data/batch/interleaved_batch.hpp>
+#include <data/batch/ragged_batch.hpp>
+#include <data/matrix/quantized_matrix.hpp>
+#include <data/matrix/tiled_matrix.hpp>
+#include <array>
+#include <span>
+#include <vector>
+#include <limits>
+#include <cstdint>
 #include <cassert>
 
 namespace MetaNN
@@ -8,9 +25,15 @@ namespace MetaNN
 
 // 矩阵乘法
 // 支持类型：
-//      矩阵与矩阵
+//      矩阵与矩阵（包括稀疏矩阵与稠密矩阵、int8量化矩阵与int8量化矩阵、分块矩阵与分块矩阵）
+//          平凡矩阵、全零矩阵与独热向量不展开为稠密矩阵
 //      矩阵与矩阵列表
 //      矩阵列表与矩阵
+//          矩阵转换为重复列表，求值时不复制，所有矩阵共享同一存储，只预处理一次（见batchDot）
+//          独热向量列表与矩阵、矩阵列表按位置取行（嵌入查找）
+//          稀疏矩阵与矩阵列表、矩阵列表与稀疏矩阵：每个矩阵都与同一个稀疏矩阵相乘，只访问非零元素
+//      批次交错存储的矩阵列表与批次交错存储的矩阵列表或者矩阵：沿批次方向乘加，结果也是批次交错存储
+//      变长矩阵列表与矩阵：所有行作为一个矩阵相乘；与矩阵列表：逐段相乘，都不填充，结果是分段相同的变长列表
 //      矩阵列表与矩阵列表
 
 // 重载OpOrganizer定义结果矩阵的行数和列数
@@ -62,6 +85,10 @@ public:
     {
         return m_colNum;
     }
+    std::size_t batchNum() const
+    {
+        return m_batchNum;
+    }
 
 private:
     std::size_t m_rowNum;
@@ -118,4 +145,884 @@ auto dot(T1&& data1, T2&& data2)
     return OpDot<T1, T2>::eval(std::forward<T1>(data1), std::forward<T2>(data2));
 }
 
+// 求值
+namespace NsDot
+{
+
+// 视图上的矩阵乘法：dest = a * b，dest的原有内容被覆盖
+// 乘加在累加类型中进行，完成后再转换为元素类型
+template<typename TElem, typename TA, typename TB>
+void dotViews(const MatrixView<TElem>& dest, const MatrixView<TA>& a, const MatrixView<TB>& b)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    const std::size_t rowNum = a.rowNum();
+    const std::size_t midNum = a.colNum();
+    const std::size_t colNum = b.colNum();
+    assert(b.rowNum() == midNum);
+    assert(dest.rowNum() == rowNum && dest.colNum() == colNum);
+
+    if (b.isRowContiguous() && dest.isRowContiguous())
+    {
+        // i-k-j顺序：内层循环在b与累加行的连续内存上进行，便于向量化
+        RowAccumulator<TElem> accumulator(colNum);
+        for (std::size_t i = 0; i < rowNum; ++i)
+        {
+            AccType* pAcc = accumulator.begin(dest.row(i).data());
+            for (std::size_t k = 0; k < midNum; ++k)
+            {
+                const AccType aik = static_cast<AccType>(a(i, k));
+                const auto* pB = b.row(k).data();
+                for (std::size_t j = 0; j < colNum; ++j)
+                {
+                    pAcc[j] += aik * static_cast<AccType>(pB[j]);
+                }
+            }
+            accumulator.finish();
+        }
+    }
+    else if (a.isRowContiguous() && b.rowStride() == 1)
+    {
+        // b是行连续矩阵的转置视图：b的每一列连续存放，计算a的行与b的列的内积
+        for (std::size_t i = 0; i < rowNum; ++i)
+        {
+            const auto* pA = a.row(i).data();
+            for (std::size_t j = 0; j < colNum; ++j)
+            {
+                const auto* pB = b.data() + j * b.colStride();
+                AccType sum{};
+                for (std::size_t k = 0; k < midNum; ++k)
+                {
+                    sum += static_cast<AccType>(pA[k]) * static_cast<AccType>(pB[k]);
+                }
+                dest(i, j) = static_cast<TElem>(sum);
+            }
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < rowNum; ++i)
+        {
+            for (std::size_t j = 0; j < colNum; ++j)
+            {
+                AccType sum{};
+                for (std::size_t k = 0; k < midNum; ++k)
+                {
+                    sum += static_cast<AccType>(a(i, k)) * static_cast<AccType>(b(k, j));
+                }
+                dest(i, j) = static_cast<TElem>(sum);
+            }
+        }
+    }
+}
+
+// 稀疏矩阵乘稠密矩阵：结果的第i行是b中若干行的线性组合，只访问a的非零元素
+template<typename TElem, typename TA, typename TB>
+void sparseDenseDot(const MatrixView<TElem>& dest, const SparseMatrixView<TA>& a, const MatrixView<TB>& b)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    const std::size_t colNum = b.colNum();
+    assert(a.colNum() == b.rowNum());
+    assert(dest.rowNum() == a.rowNum() && dest.colNum() == colNum);
+
+    RowAccumulator<TElem> accumulator(colNum);
+    for (std::size_t i = 0; i < a.rowNum(); ++i)
+    {
+        AccType* pAcc = accumulator.begin(dest.row(i).data());
+        auto indices = a.rowIndices(i);
+        auto values = a.rowValues(i);
+        for (std::size_t p = 0; p < indices.size(); ++p)
+        {
+            const AccType val = static_cast<AccType>(values[p]);
+            if (b.isRowContiguous())
+            {
+                const auto* pB = b.row(indices[p]).data();
+                for (std::size_t j = 0; j < colNum; ++j)
+                {
+                    pAcc[j] += val * static_cast<AccType>(pB[j]);
+                }
+            }
+            else
+            {
+                for (std::size_t j = 0; j < colNum; ++j)
+                {
+                    pAcc[j] += val * static_cast<AccType>(b(indices[p], j));
+                }
+            }
+        }
+        accumulator.finish();
+    }
+}
+
+// 稠密矩阵乘稀疏矩阵：a(i, k)与b第k行的非零元素相乘，累加到结果第i行的对应列，跳过a中的0
+template<typename TElem, typename TA, typename TB>
+void denseSparseDot(const MatrixView<TElem>& dest, const MatrixView<TA>& a, const SparseMatrixView<TB>& b)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    const std::size_t midNum = a.colNum();
+    assert(b.rowNum() == midNum);
+    assert(dest.rowNum() == a.rowNum() && dest.colNum() == b.colNum());
+
+    RowAccumulator<TElem> accumulator(b.colNum());
+    for (std::size_t i = 0; i < a.rowNum(); ++i)
+    {
+        AccType* pAcc = accumulator.begin(dest.row(i).data());
+        for (std::size_t k = 0; k < midNum; ++k)
+        {
+            const AccType aik = static_cast<AccType>(a(i, k));
+            if (aik == AccType{})
+            {
+                continue;
+            }
+            auto indices = b.rowIndices(k);
+            auto values = b.rowValues(k);
+            for (std::size_t p = 0; p < indices.size(); ++p)
+            {
+                pAcc[indices[p]] += aik * static_cast<AccType>(values[p]);
+            }
+        }
+        accumulator.finish();
+    }
+}
+
+// int8量化矩阵的乘法：int8乘积在int32中累加，完成后按两个操作数的量化参数重新量化为元素类型
+// 记a第i行的量化参数为(sa, za)，b的量化参数为(sb, zb)，则
+//      dest(i, j) = sa * sb * (sum_k(qa(i, k) * qb(k, j)) - zb * sum_k(qa(i, k)) - za * sum_k(qb(k, j)) + midNum * za * zb)
+// 乘积中求和的一维是b的行，因此b只能是PerTensor量化的
+template<typename TElem, typename TGranularity>
+void quantizedDot(const MatrixView<TElem>& dest, const QuantizedMatrix<TElem, DeviceTags::CPU, TGranularity>& a,
+                  const QuantizedMatrix<TElem, DeviceTags::CPU, QuantizeTags::PerTensor>& b)
+{
+    // int8乘积的绝对值不超过2^14，中间维度按MaxMidNum分段，每段的乘积在int32中累加不溢出，段间在int64中合并
+    // 零点修正后的结果（每项(qa - za) * (qb - zb)可达255^2）可能超出int32，修正与最终求和在int64中进行
+    constexpr std::size_t MaxMidNum = std::numeric_limits<std::int32_t>::max() / (128 * 128);
+    const std::size_t rowNum = a.rowNum();
+    const std::size_t midNum = a.colNum();
+    const std::size_t colNum = b.colNum();
+    assert(b.rowNum() == midNum);
+    assert(dest.rowNum() == rowNum && dest.colNum() == colNum && dest.isRowContiguous());
+
+    const auto viewA = a.quantizedView();
+    const auto viewB = b.quantizedView();
+    const std::int64_t zeroPointB = b.zeroPoint(0);
+    std::vector<std::int64_t> colSumB(colNum, 0);
+    for (std::size_t k = 0; k < midNum; ++k)
+    {
+        const std::int8_t* pB = viewB.row(k).data();
+        for (std::size_t j = 0; j < colNum; ++j)
+        {
+            colSumB[j] += pB[j];
+        }
+    }
+
+    std::vector<std::int32_t> acc(colNum);
+    std::vector<std::int64_t> total(colNum);
+    for (std::size_t i = 0; i < rowNum; ++i)
+    {
+        std::ranges::fill(total, 0);
+        const std::int8_t* pA = viewA.row(i).data();
+        std::int64_t rowSumA = 0;
+        for (std::size_t kBegin = 0; kBegin < midNum; kBegin += MaxMidNum)
+        {
+            std::ranges::fill(acc, 0);
+            const std::size_t kEnd = std::min(midNum, kBegin + MaxMidNum);
+            for (std::size_t k = kBegin; k < kEnd; ++k)
+            {
+                const std::int32_t aik = pA[k];
+                const std::int8_t* pB = viewB.row(k).data();
+                for (std::size_t j = 0; j < colNum; ++j)
+                {
+                    acc[j] += aik * pB[j];
+                }
+                rowSumA += aik;
+            }
+            for (std::size_t j = 0; j < colNum; ++j)
+            {
+                total[j] += acc[j];
+            }
+        }
+
+        const std::int64_t zeroPointA = a.zeroPoint(i);
+        const TElem scale = a.scale(i) * b.scale(0);
+        const std::int64_t offset = static_cast<std::int64_t>(midNum) * zeroPointA * zeroPointB - zeroPointB * rowSumA;
+        TElem* pDest = dest.row(i).data();
+        for (std::size_t j = 0; j < colNum; ++j)
+        {
+            pDest[j] = scale * static_cast<TElem>(total[j] - zeroPointA * colSumB[j] + offset);
+        }
+    }
+}
+
+// 分块矩阵的乘法：结果的每个块是a的一行块与b的一列块对应相乘之和，每次相乘只访问三个连续存放的块
+// 边缘块中填充的0不影响结果，因此总是按完整的块计算，块大小是编译期常量，内层循环便于展开与向量化
+template<typename TElem, std::size_t TileSize>
+void tiledDot(TiledMatrix<TElem, DeviceTags::CPU, TileSize>& dest, const TiledMatrix<TElem, DeviceTags::CPU, TileSize>& a,
+              const TiledMatrix<TElem, DeviceTags::CPU, TileSize>& b)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    assert(a.colNum() == b.rowNum());
+    assert(dest.rowNum() == a.rowNum() && dest.colNum() == b.colNum());
+
+    RowAccumulator<TElem> accumulator(TileSize * TileSize);
+    for (std::size_t ti = 0; ti < dest.tileRowNum(); ++ti)
+    {
+        for (std::size_t tj = 0; tj < dest.tileColNum(); ++tj)
+        {
+            // 整个结果块作为一行累加
+            AccType* pAcc = accumulator.begin(dest.mutableTile(ti, tj).data());
+            for (std::size_t tk = 0; tk < a.tileColNum(); ++tk)
+            {
+                const TElem* pA = a.tile(ti, tk).data();
+                const TElem* pB = b.tile(tk, tj).data();
+                for (std::size_t i = 0; i < TileSize; ++i)
+                {
+                    AccType* pAccRow = pAcc + i * TileSize;
+                    for (std::size_t k = 0; k < TileSize; ++k)
+                    {
+                        const AccType aik = static_cast<AccType>(pA[i * TileSize + k]);
+                        const TElem* pBRow = pB + k * TileSize;
+                        for (std::size_t j = 0; j < TileSize; ++j)
+                        {
+                            pAccRow[j] += aik * static_cast<AccType>(pBRow[j]);
+                        }
+                    }
+                }
+            }
+            accumulator.finish();
+        }
+    }
+}
+
+// 所有元素都为value的矩阵与b相乘：结果的每一行相同，都是value与b各列之和的乘积，只计算第一行再复制
+template<typename TElem, typename TB>
+void broadcastDenseDot(const MatrixView<TElem>& dest, TElem value, const MatrixView<TB>& b)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    const std::size_t midNum = b.rowNum();
+    const std::size_t colNum = b.colNum();
+    assert(dest.colNum() == colNum && dest.isRowContiguous());
+    if (dest.rowNum() == 0)
+    {
+        return;
+    }
+
+    RowAccumulator<TElem> accumulator(colNum);
+    AccType* pAcc = accumulator.begin(dest.row(0).data());
+    for (std::size_t k = 0; k < midNum; ++k)
+    {
+        for (std::size_t j = 0; j < colNum; ++j)
+        {
+            pAcc[j] += static_cast<AccType>(b(k, j));
+        }
+    }
+    for (std::size_t j = 0; j < colNum; ++j)
+    {
+        pAcc[j] *= static_cast<AccType>(value);
+    }
+    accumulator.finish();
+    for (std::size_t i = 1; i < dest.rowNum(); ++i)
+    {
+        std::copy_n(dest.row(0).data(), colNum, dest.row(i).data());
+    }
+}
+
+// a与所有元素都为value的矩阵相乘：结果的第i行所有元素相同，都是value与a第i行之和的乘积
+template<typename TElem, typename TA>
+void denseBroadcastDot(const MatrixView<TElem>& dest, const MatrixView<TA>& a, TElem value)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    assert(dest.rowNum() == a.rowNum() && dest.isRowContiguous());
+    for (std::size_t i = 0; i < a.rowNum(); ++i)
+    {
+        AccType sum{};
+        for (std::size_t k = 0; k < a.colNum(); ++k)
+        {
+            sum += static_cast<AccType>(a(i, k));
+        }
+        const auto row = dest.row(i);
+        std::fill(row.begin(), row.end(), static_cast<TElem>(sum * static_cast<AccType>(value)));
+    }
+}
+
+// 按位置取出b的行：dest的第i个矩阵（1行）是b的第positions[i]行
+template<typename TElem, typename TB>
+void gatherRows(const BatchMatrixView<TElem>& dest, const MatrixView<TB>& b, std::span<const std::size_t> positions)
+{
+    const std::size_t colNum = b.colNum();
+    assert(dest.batchNum() == positions.size() && dest.rowNum() == 1 && dest.colNum() == colNum);
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        assert(positions[i] < b.rowNum());
+        const auto row = dest[i].row(0);
+        if (b.isRowContiguous())
+        {
+            std::copy_n(b.row(positions[i]).data(), colNum, row.data());
+        }
+        else
+        {
+            for (std::size_t j = 0; j < colNum; ++j)
+            {
+                row[j] = b(positions[i], j);
+            }
+        }
+    }
+}
+
+// 按行连续存放的副本，用于在多次乘法之间共享的操作数：复制一次，之后每次乘法都使用行连续的实现
+template<typename TElem>
+auto packRows(const MatrixView<TElem>& src)
+{
+    Matrix<std::remove_const_t<TElem>, DeviceTags::CPU> res(src.rowNum(), src.colNum());
+    const auto dest = res.mutableView();
+    for (std::size_t i = 0; i < src.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < src.colNum(); ++j)
+        {
+            dest(i, j) = src(i, j);
+        }
+    }
+    return res;
+}
+
+// 各矩阵依次紧接存放的列表可以看作batchNum * rowNum行的一个矩阵
+template<typename TElem>
+bool isStacked(const BatchMatrixView<TElem>& view)
+{
+    return view.isRowContiguous() && view.batchStride() == view.rowNum() * view.rowStride();
+}
+
+template<typename TElem>
+MatrixView<TElem> stackedView(const BatchMatrixView<TElem>& view)
+{
+    assert(isStacked(view));
+    return MatrixView<TElem>(view.data(), view.batchNum() * view.rowNum(), view.colNum(), view.rowStride());
+}
+
+// 矩阵列表的乘法：dest[i] = a[i] * b[i]
+// 共享的操作数（矩阵间隔为0，见BatchMatrixView::isShared()）只预处理一次：
+//      右操作数共享（列表乘矩阵）：列不连续时（如转置视图）先复制为行连续的矩阵；左操作数的各矩阵紧接存放时整体作为一个矩阵相乘
+//      左操作数共享（矩阵乘列表）：列不连续时先复制为行连续的矩阵
+//      两者都共享：只计算一次，再复制到其他位置
+template<typename TElem, typename TA, typename TB>
+void batchDot(const BatchMatrixView<TElem>& dest, const BatchMatrixView<TA>& a, const BatchMatrixView<TB>& b)
+{
+    const std::size_t batchNum = dest.batchNum();
+    assert(a.batchNum() == batchNum && b.batchNum() == batchNum);
+    if (batchNum == 0)
+    {
+        return;
+    }
+
+    if (a.isShared() && b.isShared())
+    {
+        dotViews(dest[0], a[0], b[0]);
+        for (std::size_t batchId = 1; batchId < batchNum; ++batchId)
+        {
+            for (std::size_t i = 0; i < dest.rowNum(); ++i)
+            {
+                std::copy_n(dest[0].row(i).data(), dest.colNum(), dest[batchId].row(i).data());
+            }
+        }
+    }
+    else if (b.isShared())
+    {
+        auto dotShared = [&](const auto& viewB) {
+            if (isStacked(a) && isStacked(dest))
+            {
+                dotViews(stackedView(dest), stackedView(a), viewB);
+            }
+            else
+            {
+                for (std::size_t batchId = 0; batchId < batchNum; ++batchId)
+                {
+                    dotViews(dest[batchId], a[batchId], viewB);
+                }
+            }
+        };
+        if (b[0].isRowContiguous())
+        {
+            dotShared(b[0]);
+        }
+        else
+        {
+            const auto packed = packRows(b[0]);
+            dotShared(packed.view());
+        }
+    }
+    else if (a.isShared() && !a[0].isRowContiguous())
+    {
+        const auto packed = packRows(a[0]);
+        const auto viewA = packed.view();
+        for (std::size_t batchId = 0; batchId < batchNum; ++batchId)
+        {
+            dotViews(dest[batchId], viewA, b[batchId]);
+        }
+    }
+    else
+    {
+        for (std::size_t batchId = 0; batchId < batchNum; ++batchId)
+        {
+            dotViews(dest[batchId], a[batchId], b[batchId]);
+        }
+    }
+}
+
+// 批次交错存储的矩阵列表的乘法：dest(i, j)的一组通道是a(i, k)与b(k, j)两组通道逐个相乘之和
+// laneA(i, k)与laneB(k, j)返回可以按批次下标访问的对象：列表为通道的起始指针，共享矩阵为总是返回同一个值的广播行
+// 内层循环沿批次方向连续，对很小的矩阵也能填满向量寄存器
+template<typename TElem, typename TLaneA, typename TLaneB>
+void interleavedDot(InterleavedBatch<TElem, DeviceTags::CPU>& dest, std::size_t midNum, const TLaneA& laneA, const TLaneB& laneB)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    const std::size_t batchNum = dest.batchNum();
+    RowAccumulator<TElem> accumulator(batchNum);
+    for (std::size_t i = 0; i < dest.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < dest.colNum(); ++j)
+        {
+            AccType* pAcc = accumulator.begin(dest.mutableLanes(i, j).data());
+            for (std::size_t k = 0; k < midNum; ++k)
+            {
+                const auto pA = laneA(i, k);
+                const auto pB = laneB(k, j);
+                for (std::size_t b = 0; b < batchNum; ++b)
+                {
+                    pAcc[b] += static_cast<AccType>(pA[b]) * static_cast<AccType>(pB[b]);
+                }
+            }
+            accumulator.finish();
+        }
+    }
+}
+
+// 全零矩阵参与的乘法：结果为全零，另一个操作数不需要求值
+// 求值结果需要能以MatrixView参与后续运算，因此结果为稠密矩阵而不是全零矩阵
+struct CaseZero
+{
+    template<typename T1, typename T2>
+        requires MatrixC<T1> && MatrixC<T2> && (ZeroMatrixC<T1> || ZeroMatrixC<T2>)
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        using ElementType = typename T1::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(data1.rowNum(), data2.colNum());
+        for (auto row : res.mutableView())
+        {
+            std::fill(row.begin(), row.end(), ElementType{});
+        }
+        return res;
+    }
+};
+
+// 独热向量参与的乘法：独热向量在左时结果是右操作数的第hotPos行，在右时结果只有第hotPos列非0
+// 独热向量列表在左时逐个取行，与矩阵相乘即嵌入查找
+struct CaseOneHot
+{
+    template<typename T1, typename T2>
+        requires OneHotVectorC<T1> && MatrixC<T2> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto b = evaluate(data2);
+        const auto viewB = b.view();
+        using ElementType = typename T1::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(1, b.colNum());
+        const auto dest = res.mutableView().row(0);
+        for (std::size_t j = 0; j < b.colNum(); ++j)
+        {
+            dest[j] = viewB(data1.hotPos(), j);
+        }
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires (!OneHotVectorC<T1>) && MatrixC<T1> && ViewableC<EvalResult<T1>> && OneHotVectorC<T2>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto viewA = a.view();
+        using ElementType = typename T2::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(a.rowNum(), data2.colNum());
+        for (std::size_t i = 0; i < a.rowNum(); ++i)
+        {
+            const auto row = res.mutableView().row(i);
+            std::fill(row.begin(), row.end(), ElementType{});
+            row[data2.hotPos()] = viewA(i, 0);
+        }
+        return res;
+    }
+
+    // 独热向量列表与矩阵：第b个结果是矩阵的第hotPos(b)行（嵌入查找），矩阵只求值一次
+    template<typename T1, typename T2>
+        requires BatchOneHotVectorC<T1> && DuplicateC<T2> && BatchMatrixC<T2> &&
+                 requires(const T2& data) { evaluate(data.element()).view(); }
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto b = evaluate(data2.element());
+        using ElementType = typename T1::ElementType;
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(data1.batchNum(), 1, b.colNum());
+        gatherRows(res.mutableView(), b.view(), data1.hotPositions());
+        return res;
+    }
+
+    // 独热向量列表与矩阵列表：第b个结果是第b个矩阵的第hotPos(b)行
+    template<typename T1, typename T2>
+        requires BatchOneHotVectorC<T1> && (!DuplicateC<T2>) && BatchMatrixC<T2> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto b = evaluate(data2);
+        assert(data1.batchNum() == b.batchNum());
+        using ElementType = typename T1::ElementType;
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(data1.batchNum(), 1, b.colNum());
+        const auto dest = res.mutableView();
+        const auto viewB = b.view();
+        for (std::size_t batchId = 0; batchId < data1.batchNum(); ++batchId)
+        {
+            const auto row = dest[batchId].row(0);
+            for (std::size_t j = 0; j < b.colNum(); ++j)
+            {
+                row[j] = viewB(batchId, data1.hotPos(batchId), j);
+            }
+        }
+        return res;
+    }
+};
+
+// 平凡矩阵参与的乘法：按其元素值计算，不展开为稠密矩阵
+struct CaseBroadcast
+{
+    template<typename T1, typename T2>
+        requires BroadcastMatrixC<T1> && MatrixC<T2> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto b = evaluate(data2);
+        using ElementType = typename T1::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(data1.rowNum(), b.colNum());
+        broadcastDenseDot(res.mutableView(), data1.value(), b.view());
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires (!BroadcastMatrixC<T1>) && MatrixC<T1> && ViewableC<EvalResult<T1>> && BroadcastMatrixC<T2>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        using ElementType = typename T2::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(a.rowNum(), data2.colNum());
+        denseBroadcastDot(res.mutableView(), a.view(), data2.value());
+        return res;
+    }
+};
+
+// 稀疏矩阵与稠密矩阵：使用专门的实现，不展开为稠密矩阵
+struct CaseSparse
+{
+    template<typename T1, typename T2>
+        requires SparseMatrixC<T1> && MatrixC<T2> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto b = evaluate(data2);
+        Matrix<typename T1::ElementType, DeviceTags::CPU> res(data1.rowNum(), b.colNum());
+        sparseDenseDot(res.mutableView(), data1.view(), b.view());
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires MatrixC<T1> && ViewableC<EvalResult<T1>> && SparseMatrixC<T2>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        Matrix<typename T2::ElementType, DeviceTags::CPU> res(a.rowNum(), data2.colNum());
+        denseSparseDot(res.mutableView(), a.view(), data2.view());
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires BatchSparseMatrixC<T1> && BatchMatrixC<T2> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto b = evaluate(data2);
+        assert(data1.batchNum() == b.batchNum());
+        Batch<typename T1::ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(data1.batchNum(), data1.rowNum(), b.colNum());
+        const auto dest = res.mutableView();
+        const auto viewB = b.view();
+        for (std::size_t batchId = 0; batchId < data1.batchNum(); ++batchId)
+        {
+            sparseDenseDot(dest[batchId], data1.view(batchId), viewB[batchId]);
+        }
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires BatchMatrixC<T1> && ViewableC<EvalResult<T1>> && BatchSparseMatrixC<T2>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        assert(a.batchNum() == data2.batchNum());
+        Batch<typename T2::ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(a.batchNum(), a.rowNum(), data2.colNum());
+        const auto dest = res.mutableView();
+        const auto viewA = a.view();
+        for (std::size_t batchId = 0; batchId < a.batchNum(); ++batchId)
+        {
+            denseSparseDot(dest[batchId], viewA[batchId], data2.view(batchId));
+        }
+        return res;
+    }
+
+    // 稀疏矩阵与矩阵列表相乘时被转换为重复列表：每个矩阵都与同一个稀疏矩阵相乘
+    template<typename T1, typename T2>
+        requires DuplicateC<T1> && SparseMatrixC<decltype(std::declval<const T1&>().element())> &&
+                 BatchMatrixC<T2> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto& sparse = data1.element();
+        const auto b = evaluate(data2);
+        assert(data1.batchNum() == b.batchNum());
+        Batch<typename T1::ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(b.batchNum(), sparse.rowNum(), b.colNum());
+        const auto dest = res.mutableView();
+        const auto viewA = sparse.view();
+        const auto viewB = b.view();
+        for (std::size_t batchId = 0; batchId < b.batchNum(); ++batchId)
+        {
+            sparseDenseDot(dest[batchId], viewA, viewB[batchId]);
+        }
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires BatchMatrixC<T1> && ViewableC<EvalResult<T1>> &&
+                 DuplicateC<T2> && SparseMatrixC<decltype(std::declval<const T2&>().element())>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto& sparse = data2.element();
+        assert(a.batchNum() == data2.batchNum());
+        Batch<typename T2::ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(a.batchNum(), a.rowNum(), sparse.colNum());
+        const auto dest = res.mutableView();
+        const auto viewA = a.view();
+        const auto viewB = sparse.view();
+        for (std::size_t batchId = 0; batchId < a.batchNum(); ++batchId)
+        {
+            denseSparseDot(dest[batchId], viewA[batchId], viewB);
+        }
+        return res;
+    }
+};
+
+// int8量化矩阵与int8量化矩阵：使用int8乘法、int32累加的实现，结果为反量化后的稠密矩阵
+struct CaseQuantized
+{
+    template<typename T1, typename T2>
+        requires QuantizedMatrixC<EvalResult<T1>> && QuantizedMatrixC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2);
+        static_assert(!std::remove_cvref_t<decltype(b)>::PerRow, "Right operand of quantized dot must be quantized per tensor");
+        using ElementType = typename std::remove_cvref_t<decltype(a)>::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(a.rowNum(), b.colNum());
+        quantizedDot(res.mutableView(), a, b);
+        return res;
+    }
+};
+
+// 分块矩阵与分块矩阵：按块计算，结果也是分块矩阵
+struct CaseTiled
+{
+    template<typename T1, typename T2>
+        requires TiledMatrixC<EvalResult<T1>> && TiledMatrixC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2);
+        using TA = std::remove_cvref_t<decltype(a)>;
+        static_assert(TA::Tile == std::remove_cvref_t<decltype(b)>::Tile, "Tiled matrices with different tile sizes can not dot directly");
+        TA res(a.rowNum(), b.colNum());
+        tiledDot(res, a, b);
+        return res;
+    }
+};
+
+// 批次交错存储的矩阵列表：与同样存储的列表或者矩阵（重复列表）相乘，结果也是批次交错存储
+struct CaseInterleaved
+{
+    template<typename T1, typename T2>
+        requires InterleavedBatchC<EvalResult<T1>> && InterleavedBatchC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2);
+        assert(a.batchNum() == b.batchNum() && a.colNum() == b.rowNum());
+        using ElementType = typename std::remove_cvref_t<decltype(a)>::ElementType;
+        InterleavedBatch<ElementType, DeviceTags::CPU> res(a.batchNum(), a.rowNum(), b.colNum());
+        interleavedDot(res, a.colNum(),
+                       [&a](std::size_t i, std::size_t k) { return a.lanes(i, k).data(); },
+                       [&b](std::size_t k, std::size_t j) { return b.lanes(k, j).data(); });
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires InterleavedBatchC<EvalResult<T1>> && DuplicateC<T2> &&
+                 requires(const T2& data) { evaluate(data.element()).view(); }
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2.element());
+        const auto viewB = b.view();
+        assert(a.colNum() == b.rowNum());
+        using ElementType = typename std::remove_cvref_t<decltype(a)>::ElementType;
+        InterleavedBatch<ElementType, DeviceTags::CPU> res(a.batchNum(), a.rowNum(), b.colNum());
+        interleavedDot(res, a.colNum(),
+                       [&a](std::size_t i, std::size_t k) { return a.lanes(i, k).data(); },
+                       [&viewB](std::size_t k, std::size_t j) { return typename BroadcastView<ElementType>::Row(viewB(k, j)); });
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires DuplicateC<T1> && requires(const T1& data) { evaluate(data.element()).view(); } &&
+                 InterleavedBatchC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1.element());
+        const auto b = evaluate(data2);
+        const auto viewA = a.view();
+        assert(a.colNum() == b.rowNum());
+        using ElementType = typename std::remove_cvref_t<decltype(b)>::ElementType;
+        InterleavedBatch<ElementType, DeviceTags::CPU> res(b.batchNum(), a.rowNum(), b.colNum());
+        interleavedDot(res, a.colNum(),
+                       [&viewA](std::size_t i, std::size_t k) { return typename BroadcastView<ElementType>::Row(viewA(i, k)); },
+                       [&b](std::size_t k, std::size_t j) { return b.lanes(k, j).data(); });
+        return res;
+    }
+};
+
+// 变长矩阵列表在左：右操作数为矩阵（重复列表）时所有行组成的矩阵只做一次乘法，为矩阵列表时第b段与第b个矩阵相乘
+struct CaseRagged
+{
+    template<typename T1, typename T2>
+        requires RaggedBatchC<EvalResult<T1>> && DuplicateC<T2> &&
+                 requires(const T2& data) { evaluate(data.element()).view(); }
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2.element());
+        assert(a.colNum() == b.rowNum());
+        auto res = std::remove_cvref_t<decltype(a)>::withSegmentsOf(a, b.colNum());
+        dotViews(res.mutablePackedView(), a.packedView(), b.view());
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires RaggedBatchC<EvalResult<T1>> && BatchMatrixC<T2> && (!DuplicateC<T2>) && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2);
+        assert(a.batchNum() == b.batchNum() && a.colNum() == b.rowNum());
+        auto res = std::remove_cvref_t<decltype(a)>::withSegmentsOf(a, b.colNum());
+        const auto dest = res.mutablePackedView();
+        const auto viewA = a.packedView();
+        const auto viewB = b.view();
+        for (std::size_t batchId = 0; batchId < a.batchNum(); ++batchId)
+        {
+            const std::size_t begin = a.rowOffset(batchId);
+            const std::size_t end = a.rowOffset(batchId + 1);
+            dotViews(dest.subView(begin, end, 0, dest.colNum()), viewA.subView(begin, end, 0, viewA.colNum()), viewB[batchId]);
+        }
+        return res;
+    }
+};
+
+// 编译期形状的矩阵：展开计算，结果也是编译期形状的矩阵
+struct CaseFixed
+{
+    // 乘加次数不超过该值时完全展开
+    static constexpr std::size_t MaxUnrollWork = 128;
+
+    template<typename T1, typename T2>
+        requires FixedMatrixC<EvalResult<T1>> && FixedMatrixC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2);
+        using TA = std::remove_cvref_t<decltype(a)>;
+        using TB = std::remove_cvref_t<decltype(b)>;
+        static_assert(TA::ColNum == TB::RowNum, "Matrix shape mismatch");
+        constexpr std::size_t rowNum = TA::RowNum;
+        constexpr std::size_t midNum = TA::ColNum;
+        constexpr std::size_t colNum = TB::ColNum;
+        using ElementType = typename TA::ElementType;
+        using AccType = AccumulateType<ElementType, DeviceTags::CPU>;
+
+        Matrix<ElementType, DeviceTags::CPU, rowNum, colNum> res;
+        auto& dest = res.mutableElements();
+        const auto& elemA = a.elements();
+        const auto& elemB = b.elements();
+        if constexpr (rowNum * midNum * colNum <= MaxUnrollWork)
+        {
+            unrollFor<rowNum>([&](auto i) {
+                unrollFor<colNum>([&](auto j) {
+                    AccType sum{};
+                    unrollFor<midNum>([&](auto k) {
+                        sum += static_cast<AccType>(elemA[i * midNum + k]) * static_cast<AccType>(elemB[k * colNum + j]);
+                    });
+                    dest[i * colNum + j] = static_cast<ElementType>(sum);
+                });
+            });
+        }
+        else
+        {
+            // 完全展开的代码量过大时只展开最内层（结果的一行），外层使用常量边界的循环
+            for (std::size_t i = 0; i < rowNum; ++i)
+            {
+                std::array<AccType, colNum> acc{};
+                for (std::size_t k = 0; k < midNum; ++k)
+                {
+                    const AccType aik = static_cast<AccType>(elemA[i * midNum + k]);
+                    unrollFor<colNum>([&](auto j) {
+                        acc[j] += aik * static_cast<AccType>(elemB[k * colNum + j]);
+                    });
+                }
+                unrollFor<colNum>([&](auto j) {
+                    dest[i * colNum + j] = static_cast<ElementType>(acc[j]);
+                });
+            }
+        }
+        return res;
+    }
+};
+
+struct CaseGeneral
+{
+    template<typename T1, typename T2>
+        requires MatrixC<T1> && MatrixC<T2> && ViewableC<EvalResult<T1>> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2);
+        using ElementType = typename std::remove_cvref_t<decltype(a)>::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(a.rowNum(), b.colNum());
+        dotViews(res.mutableView(), a.view(), b.view());
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires BatchMatrixC<T1> && BatchMatrixC<T2> && ViewableC<EvalResult<T1>> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto a = evaluate(data1);
+        const auto b = evaluate(data2);
+        assert(a.batchNum() == b.batchNum());
+        using ElementType = typename std::remove_cvref_t<decltype(a)>::ElementType;
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(a.batchNum(), a.rowNum(), b.colNum());
+        batchDot(res.mutableView(), a.view(), b.view());
+        return res;
+    }
+};
+
+} // namespace NsDot
+
+template<>
+struct OpSeq_<BinaryOpTags::Dot>
+{
+    using type = OpSeqContainer<NsDot::CaseFixed, NsDot::CaseZero, NsDot::CaseOneHot, NsDot::CaseBroadcast, NsDot::CaseSparse, NsDot::CaseQuantized, NsDot::CaseTiled, NsDot::CaseInterleaved, NsDot::CaseRagged, NsDot::CaseGeneral>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
 
 namespace MetaNN
 {
@@ -32,8 +33,8 @@ public:
     {
         if constexpr (ScalarC<T1> && MatrixC<T2>)
         {
-            using ElementType = typename T2::ElementType;
-            using DeviceType = typename T2::DeviceType;
+            using ElementType = typename RawT2::ElementType;
+            using DeviceType = typename RawT2::DeviceType;
             auto tmpTrivialMatix = makeTrivialMatrix<ElementType, DeviceType>(data2.rowNum(), data2.colNum(), data1);
             using ResType = BinaryOp<BinaryOpTags::ElementMul, std::remove_cvref_t<decltype(tmpTrivialMatix)>, RawT2>;
             return ResType(std::move(tmpTrivialMatix), std::forward<T2>(data2));
@@ -48,8 +49,8 @@ public:
     {
         if constexpr (ScalarC<T1> && BatchMatrixC<T2>)
         {
-            using ElementType = typename T2::ElementType;
-            using DeviceType = typename T2::DeviceType;
+            using ElementType = typename RawT2::ElementType;
+            using DeviceType = typename RawT2::DeviceType;
             auto tmpTrivialMatrix = makeTrivialMatrix<ElementType, DeviceType>(data2.rowNum(), data2.colNum(), data1);
             auto tmpDuplicateTrivialMatrix = makeDuplicate(data2.batchNum(), std::move(tmpTrivialMatrix));
             using ResType = BinaryOp<BinaryOpTags::ElementMul, std::remove_cvref_t<decltype(tmpDuplicateTrivialMatrix)>, RawT2>;
@@ -67,7 +68,7 @@ public:
         static_assert(std::is_same_v<typename RawT1::DeviceType, typename RawT2::DeviceType>, "Matrices with different device types can not multiply directly");
         if constexpr (MatrixC<T1> && BatchMatrixC<T2>)
         {
-            auto tmpDuplicateMatrix = makeDuplicate(data2.batchNum(), std::move(data1));
+            auto tmpDuplicateMatrix = makeDuplicate(data2.batchNum(), std::forward<T1>(data1));
             using ResType = BinaryOp<BinaryOpTags::ElementMul, std::remove_cvref_t<decltype(tmpDuplicateMatrix)>, RawT2>;
             return ResType(std::move(tmpDuplicateMatrix), std::forward<T2>(data2));
         }
@@ -92,4 +93,23 @@ auto operator*(T1&& data1, T2&& data2)
     return OpElementMul<T1, T2>::eval(std::forward<T1>(data1), std::forward<T2>(data2));
 }
 
+// 求值：逐元素相乘
+namespace NsElementMul
+{
+struct ElementFunc
+{
+    template<typename TElem>
+    TElem operator()(TElem a, TElem b) const
+    {
+        return a * b;
+    }
+};
+} // namespace NsElementMul
+
+template<>
+struct OpSeq_<BinaryOpTags::ElementMul>
+{
+    using type = OpSeqContainer<CaseFixedElementwise<NsElementMul::ElementFunc>, CaseElementwise<NsElementMul::ElementFunc>>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <data/numeric_policy.hpp>
 
 namespace MetaNN
 {
@@ -9,6 +11,7 @@ namespace MetaNN
 // 支持类型：
 //      矩阵、矩阵、矩阵
 //      矩阵列表、矩阵列表、矩阵列表
+// 结果为data1 * data3 + data2 * (1 - data3)，即以data3为权重在data1与data2之间插值
 
 template<typename T1, typename T2, typename T3>
 class OpInterpolation
@@ -37,4 +40,25 @@ auto interpolation(T1&& data1, T2&& data2, T3&& data3)
     return OpInterpolation<T1, T2, T3>::eval(std::forward<T1>(data1), std::forward<T2>(data2), std::forward<T3>(data3));
 }
 
+// 求值：逐元素计算，16位浮点元素在累加类型中计算后再舍入
+namespace NsInterpolation
+{
+struct ElementFunc
+{
+    template<typename TElem>
+    TElem operator()(TElem a, TElem b, TElem lambda) const
+    {
+        using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+        const AccType weight = static_cast<AccType>(lambda);
+        return static_cast<TElem>(static_cast<AccType>(a) * weight + static_cast<AccType>(b) * (1 - weight));
+    }
+};
+} // namespace NsInterpolation
+
+template<>
+struct OpSeq_<TernaryOpTags::Interpolation>
+{
+    using type = OpSeqContainer<CaseFixedElementwise<NsInterpolation::ElementFunc>, CaseElementwise<NsInterpolation::ElementFunc>>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
@@ -1,14 +1,23 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <evaluate/broadcast.hpp>
+#include <evaluate/accumulate.hpp>
+#include <data/scalar.hpp>
+#include <data/batch/batch.hpp>
+#include <data/batch/batch_one_hot_vector.hpp>
+#include <cmath>
+#include <cassert>
 
 namespace MetaNN
 {
 
-// NegativeLogLikelihood operation
+// NegativeLogLikelihood operation：-sum(truth * log(pred))，第一个操作数为真实值，第二个为预测值
 // 支持类型：
 //      矩阵与矩阵：输出为标量
 //      矩阵列表与矩阵列表：输出为标量列表
+// 真实值为独热向量（列表）时只读取预测值在hotPos处的元素，计算量与列数无关
 
 template<>
 struct OpCategory_<BinaryOpTags::NegativeLogLikelihood, CategoryTags::Matrix, CategoryTags::Matrix>
@@ -17,11 +26,44 @@ struct OpCategory_<BinaryOpTags::NegativeLogLikelihood, CategoryTags::Matrix, Ca
 };
 
 template<>
-struct OpCategory_<BinaryOpTags::NegativeLogLikelihood, CategoryTags::BatchMatrix, CategoryTags::Matrix>
+struct OpCategory_<BinaryOpTags::NegativeLogLikelihood, CategoryTags::BatchMatrix, CategoryTags::BatchMatrix>
 {
     using type = CategoryTags::BatchScalar;
 };
 
+// 结果是标量（列表），由形状相同的两个矩阵（列表）得到
+template<>
+class OpOrganizer<BinaryOpTags::NegativeLogLikelihood, CategoryTags::Scalar>
+{
+public:
+    template<MatrixC T1, MatrixC T2>
+    OpOrganizer([[maybe_unused]] const T1& data1, [[maybe_unused]] const T2& data2)
+    {
+        assert(data1.rowNum() == data2.rowNum() && data1.colNum() == data2.colNum());
+    }
+};
+
+template<>
+class OpOrganizer<BinaryOpTags::NegativeLogLikelihood, CategoryTags::BatchScalar>
+{
+public:
+    template<BatchMatrixC T1, BatchMatrixC T2>
+    OpOrganizer(const T1& data1, [[maybe_unused]] const T2& data2)
+        : m_batchNum(data1.batchNum())
+    {
+        assert(data1.rowNum() == data2.rowNum() && data1.colNum() == data2.colNum());
+        assert(data1.batchNum() == data2.batchNum());
+    }
+
+    std::size_t batchNum() const
+    {
+        return m_batchNum;
+    }
+
+private:
+    std::size_t m_batchNum;
+};
+
 template<typename T1, typename T2>
 class OpNegativeLogLikelihood
 {
@@ -45,4 +87,100 @@ auto negativeLogLikelihood(T1&& data1, T2&& data2)
     return OpNegativeLogLikelihood<T1, T2>::eval(std::forward<T1>(data1), std::forward<T2>(data2));
 }
 
+// 求值
+namespace NsNegativeLogLikelihood
+{
+
+// 单个矩阵的负对数似然，真实值为0的位置不参与计算（避免0 * log(0)）
+template<typename TAcc, typename TTruth, typename TPred>
+TAcc matrixLoss(const TTruth& truth, const TPred& pred)
+{
+    TAcc sum{};
+    for (std::size_t i = 0; i < truth.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < truth.colNum(); ++j)
+        {
+            const TAcc t = static_cast<TAcc>(truth(i, j));
+            if (t != TAcc{})
+            {
+                sum -= t * std::log(static_cast<TAcc>(pred(i, j)));
+            }
+        }
+    }
+    return sum;
+}
+
+// 真实值为独热向量（列表）：-log(pred(0, hotPos))
+struct CaseOneHot
+{
+    template<typename T1, typename T2>
+        requires OneHotVectorC<T1> && MatrixC<T2> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& truth, const T2& pred)
+    {
+        using ElementType = typename T1::ElementType;
+        using AccType = AccumulateType<ElementType, DeviceTags::CPU>;
+        const auto p = evaluate(pred);
+        return Scalar<ElementType, DeviceTags::CPU>(
+            static_cast<ElementType>(-std::log(static_cast<AccType>(p.view()(0, truth.hotPos())))));
+    }
+
+    template<typename T1, typename T2>
+        requires BatchOneHotVectorC<T1> && BatchMatrixC<T2> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& truth, const T2& pred)
+    {
+        using ElementType = typename T1::ElementType;
+        using AccType = AccumulateType<ElementType, DeviceTags::CPU>;
+        const auto p = evaluate(pred);
+        const auto viewP = p.view();
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Scalar> res(truth.batchNum());
+        const auto dest = res.mutableView();
+        for (std::size_t batchId = 0; batchId < truth.batchNum(); ++batchId)
+        {
+            dest[batchId] = static_cast<ElementType>(-std::log(static_cast<AccType>(viewP(batchId, 0, truth.hotPos(batchId)))));
+        }
+        return res;
+    }
+};
+
+struct CaseGeneral
+{
+    template<typename T1, typename T2>
+        requires MatrixC<T1> && MatrixC<T2> && ViewableC<EvalResult<T1>> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& truth, const T2& pred)
+    {
+        using ElementType = typename T1::ElementType;
+        using AccType = AccumulateType<ElementType, DeviceTags::CPU>;
+        const auto t = evaluate(truth);
+        const auto p = evaluate(pred);
+        return Scalar<ElementType, DeviceTags::CPU>(static_cast<ElementType>(matrixLoss<AccType>(t.view(), p.view())));
+    }
+
+    template<typename T1, typename T2>
+        requires BatchMatrixC<T1> && BatchMatrixC<T2> && ViewableC<EvalResult<T1>> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& truth, const T2& pred)
+    {
+        using ElementType = typename T1::ElementType;
+        using AccType = AccumulateType<ElementType, DeviceTags::CPU>;
+        const auto t = evaluate(truth);
+        const auto p = evaluate(pred);
+        const auto viewT = t.view();
+        const auto viewP = p.view();
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Scalar> res(t.batchNum());
+        const auto dest = res.mutableView();
+        for (std::size_t batchId = 0; batchId < t.batchNum(); ++batchId)
+        {
+            dest[batchId] = static_cast<ElementType>(matrixLoss<AccType>(viewT[batchId], viewP[batchId]));
+        }
+        return res;
+    }
+};
+
+} // namespace NsNegativeLogLikelihood
+
+template<>
+struct OpSeq_<BinaryOpTags::NegativeLogLikelihood>
+{
+    using type = OpSeqContainer<NsNegativeLogLikelihood::CaseOneHot, NsNegativeLogLikelihood::CaseGeneral>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
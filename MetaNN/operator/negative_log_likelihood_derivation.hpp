@@ -1,14 +1,22 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <evaluate/broadcast.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <data/batch/batch_one_hot_vector.hpp>
+#include <algorithm>
+#include <cassert>
 
 namespace MetaNN
 {
 
-// NegativeLogLikelihoodDerivation operation：三元运算符
+// NegativeLogLikelihoodDerivation operation：三元运算符，依次为梯度、真实值与预测值，结果为-grad * truth / pred
 // 支持类型：
 //      标量、矩阵、矩阵：输出为矩阵
 //      标量列表、矩阵列表、矩阵列表：输出为矩阵列表
+// 真实值为独热向量（列表）时结果只有hotPos处非0，只计算该处的值，其余位置直接置0
 
 template<>
 struct OpCategory_<TernaryOpTags::NegativeLogLikelihoodDerivation,
@@ -24,6 +32,66 @@ struct OpCategory_<TernaryOpTags::NegativeLogLikelihoodDerivation,
     using type = CategoryTags::BatchMatrix;
 };
 
+// 结果的形状与真实值相同
+template<>
+class OpOrganizer<TernaryOpTags::NegativeLogLikelihoodDerivation, CategoryTags::Matrix>
+{
+public:
+    template<ScalarC T1, MatrixC T2, MatrixC T3>
+    OpOrganizer([[maybe_unused]] const T1& grad, const T2& truth, [[maybe_unused]] const T3& pred)
+        : m_rowNum(truth.rowNum())
+        , m_colNum(truth.colNum())
+    {
+        assert(truth.rowNum() == pred.rowNum() && truth.colNum() == pred.colNum());
+    }
+
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+
+private:
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+};
+
+template<>
+class OpOrganizer<TernaryOpTags::NegativeLogLikelihoodDerivation, CategoryTags::BatchMatrix>
+{
+public:
+    template<BatchScalarC T1, BatchMatrixC T2, BatchMatrixC T3>
+    OpOrganizer([[maybe_unused]] const T1& grad, const T2& truth, [[maybe_unused]] const T3& pred)
+        : m_rowNum(truth.rowNum())
+        , m_colNum(truth.colNum())
+        , m_batchNum(truth.batchNum())
+    {
+        assert(truth.rowNum() == pred.rowNum() && truth.colNum() == pred.colNum());
+        assert(grad.batchNum() == truth.batchNum() && pred.batchNum() == truth.batchNum());
+    }
+
+    std::size_t rowNum() const
+    {
+        return m_rowNum;
+    }
+    std::size_t colNum() const
+    {
+        return m_colNum;
+    }
+    std::size_t batchNum() const
+    {
+        return m_batchNum;
+    }
+
+private:
+    std::size_t m_rowNum;
+    std::size_t m_colNum;
+    std::size_t m_batchNum;
+};
+
 
 template<typename T1, typename T2, typename T3>
 class OpNegativeLogLikelihoodDerivation
@@ -45,11 +113,113 @@ public:
 };
 
 template<typename T1, typename T2, typename T3>
-    requires (MatrixC<T1> && MatrixC<T2> && MatrixC<T3>) ||
-             (BatchMatrixC<T1> && BatchMatrixC<T2> && BatchMatrixC<T3>)
+    requires (ScalarC<T1> && MatrixC<T2> && MatrixC<T3>) ||
+             (BatchScalarC<T1> && BatchMatrixC<T2> && BatchMatrixC<T3>)
 auto negativeLogLikelihoodDerivation(T1&& data1, T2&& data2, T3&& data3)
 {
     return OpNegativeLogLikelihoodDerivation<T1, T2, T3>::eval(std::forward<T1>(data1), std::forward<T2>(data2), std::forward<T3>(data3));
 }
 
+// 求值
+namespace NsNegativeLogLikelihoodDerivation
+{
+
+// 单个矩阵的导数：-grad * truth / pred，真实值为0的位置结果为0
+template<typename TElem, typename TTruth, typename TPred>
+void matrixDerivation(const MatrixView<TElem>& dest, TElem grad, const TTruth& truth, const TPred& pred)
+{
+    for (std::size_t i = 0; i < truth.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < truth.colNum(); ++j)
+        {
+            const TElem t = truth(i, j);
+            dest(i, j) = (t == TElem{}) ? TElem{} : -grad * t / pred(i, j);
+        }
+    }
+}
+
+// 真实值为独热向量（列表）：结果置0后只写入hotPos处的-grad / pred(0, hotPos)
+struct CaseOneHot
+{
+    template<typename T1, typename T2, typename T3>
+        requires ScalarC<T1> && OneHotVectorC<T2> && MatrixC<T3> && ViewableC<EvalResult<T3>>
+    static auto eval(const T1& grad, const T2& truth, const T3& pred)
+    {
+        using ElementType = typename T2::ElementType;
+        const ElementType g = evaluate(grad).value();
+        const auto p = evaluate(pred);
+        Matrix<ElementType, DeviceTags::CPU> res(1, truth.colNum());
+        const auto row = res.mutableView().row(0);
+        std::fill(row.begin(), row.end(), ElementType{});
+        row[truth.hotPos()] = -g / p.view()(0, truth.hotPos());
+        return res;
+    }
+
+    template<typename T1, typename T2, typename T3>
+        requires BatchScalarC<T1> && ViewableC<EvalResult<T1>> && BatchOneHotVectorC<T2> &&
+                 BatchMatrixC<T3> && ViewableC<EvalResult<T3>>
+    static auto eval(const T1& grad, const T2& truth, const T3& pred)
+    {
+        using ElementType = typename T2::ElementType;
+        const auto g = evaluate(grad);
+        const auto p = evaluate(pred);
+        const auto viewG = g.view();
+        const auto viewP = p.view();
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(truth.batchNum(), 1, truth.colNum());
+        const auto dest = res.mutableView();
+        for (std::size_t batchId = 0; batchId < truth.batchNum(); ++batchId)
+        {
+            const std::size_t pos = truth.hotPos(batchId);
+            const auto row = dest[batchId].row(0);
+            std::fill(row.begin(), row.end(), ElementType{});
+            row[pos] = -viewG[batchId] / viewP(batchId, 0, pos);
+        }
+        return res;
+    }
+};
+
+struct CaseGeneral
+{
+    template<typename T1, typename T2, typename T3>
+        requires ScalarC<T1> && MatrixC<T2> && MatrixC<T3> && ViewableC<EvalResult<T2>> && ViewableC<EvalResult<T3>>
+    static auto eval(const T1& grad, const T2& truth, const T3& pred)
+    {
+        using ElementType = typename T2::ElementType;
+        const auto t = evaluate(truth);
+        const auto p = evaluate(pred);
+        Matrix<ElementType, DeviceTags::CPU> res(t.rowNum(), t.colNum());
+        matrixDerivation<ElementType>(res.mutableView(), evaluate(grad).value(), t.view(), p.view());
+        return res;
+    }
+
+    template<typename T1, typename T2, typename T3>
+        requires BatchScalarC<T1> && ViewableC<EvalResult<T1>> && BatchMatrixC<T2> && BatchMatrixC<T3> &&
+                 ViewableC<EvalResult<T2>> && ViewableC<EvalResult<T3>>
+    static auto eval(const T1& grad, const T2& truth, const T3& pred)
+    {
+        using ElementType = typename T2::ElementType;
+        const auto g = evaluate(grad);
+        const auto t = evaluate(truth);
+        const auto p = evaluate(pred);
+        const auto viewG = g.view();
+        const auto viewT = t.view();
+        const auto viewP = p.view();
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(t.batchNum(), t.rowNum(), t.colNum());
+        const auto dest = res.mutableView();
+        for (std::size_t batchId = 0; batchId < t.batchNum(); ++batchId)
+        {
+            matrixDerivation<ElementType>(dest[batchId], viewG[batchId], viewT[batchId], viewP[batchId]);
+        }
+        return res;
+    }
+};
+
+} // namespace NsNegativeLogLikelihoodDerivation
+
+template<>
+struct OpSeq_<TernaryOpTags::NegativeLogLikelihoodDerivation>
+{
+    using type = OpSeqContainer<NsNegativeLogLikelihoodDerivation::CaseOneHot, NsNegativeLogLikelihoodDerivation::CaseGeneral>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
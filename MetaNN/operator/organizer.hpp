@@ -17,7 +17,7 @@ class OpOrganizer<TOpTag, CategoryTags::Scalar>
 {
 public:
     template<ScalarC THead, ScalarC... TRemain>
-    OpOrganizer(const THead& head, const TRemain&... remain)
+    OpOrganizer(const THead& head, [[maybe_unused]] const TRemain&... remain)
     {
     }
 };
@@ -27,7 +27,7 @@ class OpOrganizer<TOpTag, CategoryTags::Matrix>
 {
 public:
     template<MatrixC THead, MatrixC... TRemain>
-    OpOrganizer(const THead& head, const TRemain&... remain)
+    OpOrganizer(const THead& head, [[maybe_unused]] const TRemain&... remain)
         : m_rowNum(head.rowNum())
         , m_colNum(head.colNum())
     {
@@ -52,8 +52,8 @@ class OpOrganizer<TOpTag, CategoryTags::BatchScalar>
 {
 public:
     template<BatchScalarC THead, BatchScalarC... TRemain>
-    OpOrganizer(const THead& head, const TRemain&... remain)
-        : m_batchNum(head.batchNum)
+    OpOrganizer(const THead& head, [[maybe_unused]] const TRemain&... remain)
+        : m_batchNum(head.batchNum())
     {
         assert((true && ... && (head.batchNum() == remain.batchNum())));
     }
@@ -70,10 +70,10 @@ class OpOrganizer<TOpTag, CategoryTags::BatchMatrix>
 {
 public:
     template<BatchMatrixC THead, BatchMatrixC... TRemain>
-    OpOrganizer(const THead& head, const TRemain&... remain)
+    OpOrganizer(const THead& head, [[maybe_unused]] const TRemain&... remain)
         : m_rowNum(head.rowNum())
         , m_colNum(head.colNum())
-        , m_batchNum(head.batchNum)
+        , m_batchNum(head.batchNum())
     {
         assert((true && ... && (head.rowNum() == remain.rowNum())));
         assert((true && ... && (head.colNum() == remain.colNum())));
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/quantized_matrix.hpp>
+
+namespace MetaNN
+{
+
+// 量化与反量化：仅针对矩阵
+// quantize<TGranularity>(data)求值得到int8量化矩阵，dequantize(data)将求值结果为量化矩阵的数据还原为稠密矩阵
+// 两者的类别与元素类型都与操作数相同，量化矩阵之间的矩阵乘法见dot.hpp
+
+template<typename TGranularity, typename T>
+class OpQuantize
+{
+    using RawT = std::remove_cvref_t<T>;
+public:
+    static auto eval(T&& data)
+    {
+        using ResType = UnaryOp<UnaryOpTags::Quantize<TGranularity>, RawT>;
+        return ResType(std::forward<T>(data));
+    }
+};
+
+template<typename TGranularity = QuantizeTags::PerTensor, typename T> requires MatrixC<T>
+auto quantize(T&& data)
+{
+    return OpQuantize<TGranularity, T>::eval(std::forward<T>(data));
+}
+
+template<typename T>
+class OpDequantize
+{
+    using RawT = std::remove_cvref_t<T>;
+public:
+    static auto eval(T&& data)
+    {
+        using ResType = UnaryOp<UnaryOpTags::Dequantize, RawT>;
+        return ResType(std::forward<T>(data));
+    }
+};
+
+template<typename T> requires MatrixC<T>
+auto dequantize(T&& data)
+{
+    return OpDequantize<T>::eval(std::forward<T>(data));
+}
+
+// 求值
+// 量化矩阵求值结果为其自身（浅拷贝，共享存储）
+template<typename TElem, typename TDevice, typename TGranularity>
+struct DataEvaluator_<QuantizedMatrix<TElem, TDevice, TGranularity>>
+{
+    static auto eval(const QuantizedMatrix<TElem, TDevice, TGranularity>& data)
+    {
+        return data;
+    }
+};
+
+namespace NsQuantize
+{
+template<typename TGranularity>
+struct CaseQuantize
+{
+    template<typename T>
+        requires MatrixC<T> && ViewableC<EvalResult<T>>
+    static auto eval(const T& data)
+    {
+        return makeQuantized<TGranularity>(evaluate(data));
+    }
+};
+
+struct CaseDequantize
+{
+    template<typename T>
+        requires QuantizedMatrixC<EvalResult<T>>
+    static auto eval(const T& data)
+    {
+        return makeDense(evaluate(data));
+    }
+};
+} // namespace NsQuantize
+
+template<typename TGranularity>
+struct OpSeq_<UnaryOpTags::Quantize<TGranularity>>
+{
+    using type = OpSeqContainer<NsQuantize::CaseQuantize<TGranularity>>;
+};
+
+template<>
+struct OpSeq_<UnaryOpTags::Dequantize>
+{
+    using type = OpSeqContainer<NsQuantize::CaseDequantize>;
+};
+
+} // namespace MetaNN
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <cmath>
 
 // sigmoid function : S(x) = 1/(1+e^(-x))
 // map (-infinity, +inifinity) to (0, 1)
@@ -28,4 +30,23 @@ auto sigmoid(T&& data)
     return OpSigmoid<T>::eval(std::forward<T>(data));
 }
 
+// 求值：逐元素计算sigmoid
+namespace NsSigmoid
+{
+struct ElementFunc
+{
+    template<typename TElem>
+    TElem operator()(TElem a) const
+    {
+        return static_cast<TElem>(1 / (1 + std::exp(-a)));
+    }
+};
+} // namespace NsSigmoid
+
+template<>
+struct OpSeq_<UnaryOpTags::Sigmoid>
+{
+    using type = OpSeqContainer<CaseFixedElementwise<NsSigmoid::ElementFunc>, CaseElementwise<NsSigmoid::ElementFunc>>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
 
 namespace MetaNN
 {
@@ -25,4 +26,23 @@ auto sign(T&& data)
     return OpSign<T>::eval(std::forward<T>(data));
 }
 
+// 求值：逐元素取符号
+namespace NsSign
+{
+struct ElementFunc
+{
+    template<typename TElem>
+    TElem operator()(TElem a) const
+    {
+        return static_cast<TElem>((TElem{} < a) - (a < TElem{}));
+    }
+};
+} // namespace NsSign
+
+template<>
+struct OpSeq_<UnaryOpTags::Sign>
+{
+    using type = OpSeqContainer<CaseFixedElementwise<NsSign::ElementFunc>, CaseElementwise<NsSign::ElementFunc>>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
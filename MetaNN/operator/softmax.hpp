@@ -1,11 +1,20 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <evaluate/accumulate.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/fixed_matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
 
 namespace MetaNN
 {
 
 // VecSoftMax：将输入矩阵归一化，用于矩阵和矩阵列表
+// 对每一行分别归一化：dest(i, j) = exp(src(i, j)) / sum_k(exp(src(i, k)))
 template<typename T>
 class OpVecSoftmax
 {
@@ -25,5 +34,93 @@ auto vecSoftmax(T&& data)
     return OpVecSoftmax<T>::eval(std::forward<T>(data));
 }
 
+// 求值：逐行计算
+// 先减去行内最大值再求指数，避免溢出；指数、求和与归一化都在累加类型中进行，16位浮点元素只在写回结果时舍入一次
+namespace NsVecSoftmax
+{
+template<typename TElem, typename TSrc>
+void softmaxRows(const MatrixView<TElem>& dest, const MatrixView<TSrc>& src)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    const std::size_t colNum = src.colNum();
+    assert(dest.rowNum() == src.rowNum() && dest.colNum() == colNum);
+    if (colNum == 0)
+    {
+        return;
+    }
+
+    RowAccumulator<TElem> accumulator(colNum);
+    for (std::size_t i = 0; i < src.rowNum(); ++i)
+    {
+        AccType* pAcc = accumulator.begin(dest.row(i).data());
+        for (std::size_t j = 0; j < colNum; ++j)
+        {
+            pAcc[j] = static_cast<AccType>(src(i, j));
+        }
+        const AccType maxVal = *std::max_element(pAcc, pAcc + colNum);
+        AccType sum{};
+        for (std::size_t j = 0; j < colNum; ++j)
+        {
+            pAcc[j] = std::exp(pAcc[j] - maxVal);
+            sum += pAcc[j];
+        }
+        for (std::size_t j = 0; j < colNum; ++j)
+        {
+            pAcc[j] /= sum;
+        }
+        accumulator.finish();
+    }
+}
+
+// 编译期形状的矩阵：结果也是编译期形状的矩阵
+struct CaseFixed
+{
+    template<typename T>
+        requires FixedMatrixC<EvalResult<T>>
+    static auto eval(const T& data)
+    {
+        const auto mat = evaluate(data);
+        std::remove_cvref_t<decltype(mat)> res;
+        softmaxRows(res.mutableView(), mat.view());
+        return res;
+    }
+};
+
+struct CaseGeneral
+{
+    template<typename T>
+        requires MatrixC<T> && ViewableC<EvalResult<T>>
+    static auto eval(const T& data)
+    {
+        const auto mat = evaluate(data);
+        using ElementType = typename std::remove_cvref_t<decltype(mat)>::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(mat.rowNum(), mat.colNum());
+        softmaxRows(res.mutableView(), mat.view());
+        return res;
+    }
+
+    template<typename T>
+        requires BatchMatrixC<T> && ViewableC<EvalResult<T>>
+    static auto eval(const T& data)
+    {
+        const auto batch = evaluate(data);
+        using ElementType = typename std::remove_cvref_t<decltype(batch)>::ElementType;
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(batch.batchNum(), batch.rowNum(), batch.colNum());
+        const auto dest = res.mutableView();
+        const auto src = batch.view();
+        for (std::size_t batchId = 0; batchId < batch.batchNum(); ++batchId)
+        {
+            softmaxRows(dest[batchId], src[batchId]);
+        }
+        return res;
+    }
+};
+} // namespace NsVecSoftmax
+
+template<>
+struct OpSeq_<UnaryOpTags::VecSoftmax>
+{
+    using type = OpSeqContainer<NsVecSoftmax::CaseFixed, NsVecSoftmax::CaseGeneral>;
+};
 
 } // namespace MetaNN
\ No newline at end of file
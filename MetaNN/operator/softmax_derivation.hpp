@@ -1,6 +1,13 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <evaluate/accumulate.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/fixed_matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <type_traits>
+#include <cassert>
 
 namespace MetaNN
 {
@@ -9,6 +16,8 @@ namespace MetaNN
 // 支持类型：
 //      矩阵与矩阵
 //      矩阵列表与矩阵列表
+// data1为反向传播的梯度，data2为vecSoftmax的输出，逐行计算：
+//      dest(i, j) = data2(i, j) * (data1(i, j) - sum_k(data1(i, k) * data2(i, k)))
 
 template<typename T1, typename T2>
 class OpVecSoftmaxDerivation
@@ -33,4 +42,89 @@ auto vecSoftmaxDerivation(T1&& data1, T2&& data2)
     return OpVecSoftmaxDerivation<T1, T2>::eval(std::forward<T1>(data1), std::forward<T2>(data2));
 }
 
+// 求值：逐行计算，内积与结果都在累加类型中计算，16位浮点元素只在写回结果时舍入一次
+namespace NsVecSoftmaxDerivation
+{
+template<typename TElem, typename TGrad, typename TOut>
+void softmaxDerivationRows(const MatrixView<TElem>& dest, const MatrixView<TGrad>& grad, const MatrixView<TOut>& out)
+{
+    using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+    const std::size_t colNum = grad.colNum();
+    assert(grad.rowNum() == out.rowNum() && colNum == out.colNum());
+    assert(dest.rowNum() == grad.rowNum() && dest.colNum() == colNum);
+
+    RowAccumulator<TElem> accumulator(colNum);
+    for (std::size_t i = 0; i < grad.rowNum(); ++i)
+    {
+        AccType* pAcc = accumulator.begin(dest.row(i).data());
+        AccType weighted{};
+        for (std::size_t j = 0; j < colNum; ++j)
+        {
+            weighted += static_cast<AccType>(grad(i, j)) * static_cast<AccType>(out(i, j));
+        }
+        for (std::size_t j = 0; j < colNum; ++j)
+        {
+            pAcc[j] = static_cast<AccType>(out(i, j)) * (static_cast<AccType>(grad(i, j)) - weighted);
+        }
+        accumulator.finish();
+    }
+}
+
+// 编译期形状的矩阵：结果也是编译期形状的矩阵
+struct CaseFixed
+{
+    template<typename T1, typename T2>
+        requires FixedMatrixC<EvalResult<T1>> && FixedMatrixC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto grad = evaluate(data1);
+        const auto out = evaluate(data2);
+        static_assert(std::is_same_v<decltype(grad), decltype(out)>, "Matrix shape mismatch");
+        std::remove_cvref_t<decltype(grad)> res;
+        softmaxDerivationRows(res.mutableView(), grad.view(), out.view());
+        return res;
+    }
+};
+
+struct CaseGeneral
+{
+    template<typename T1, typename T2>
+        requires MatrixC<T1> && MatrixC<T2> && ViewableC<EvalResult<T1>> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto grad = evaluate(data1);
+        const auto out = evaluate(data2);
+        using ElementType = typename std::remove_cvref_t<decltype(grad)>::ElementType;
+        Matrix<ElementType, DeviceTags::CPU> res(grad.rowNum(), grad.colNum());
+        softmaxDerivationRows(res.mutableView(), grad.view(), out.view());
+        return res;
+    }
+
+    template<typename T1, typename T2>
+        requires BatchMatrixC<T1> && BatchMatrixC<T2> && ViewableC<EvalResult<T1>> && ViewableC<EvalResult<T2>>
+    static auto eval(const T1& data1, const T2& data2)
+    {
+        const auto grad = evaluate(data1);
+        const auto out = evaluate(data2);
+        assert(grad.batchNum() == out.batchNum());
+        using ElementType = typename std::remove_cvref_t<decltype(grad)>::ElementType;
+        Batch<ElementType, DeviceTags::CPU, CategoryTags::Matrix> res(grad.batchNum(), grad.rowNum(), grad.colNum());
+        const auto dest = res.mutableView();
+        const auto viewGrad = grad.view();
+        const auto viewOut = out.view();
+        for (std::size_t batchId = 0; batchId < grad.batchNum(); ++batchId)
+        {
+            softmaxDerivationRows(dest[batchId], viewGrad[batchId], viewOut[batchId]);
+        }
+        return res;
+    }
+};
+} // namespace NsVecSoftmaxDerivation
+
+template<>
+struct OpSeq_<BinaryOpTags::VecSoftmaxDerivation>
+{
+    using type = OpSeqContainer<NsVecSoftmaxDerivation::CaseFixed, NsVecSoftmaxDerivation::CaseGeneral>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
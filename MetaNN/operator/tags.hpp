@@ -13,6 +13,8 @@ struct UnaryOpTags
     struct Transpose;
     struct Collapse;
     struct VecSoftmax;
+    template<typename TGranularity> struct Quantize;
+    struct Dequantize;
 };
 
 // 二元运算
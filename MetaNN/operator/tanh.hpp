@@ -1,6 +1,8 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <cmath>
 
 namespace MetaNN
 {
@@ -25,4 +27,23 @@ auto tanh(T&& data)
     return OpTanh<T>::eval(std::forward<T>(data));
 }
 
+// 求值：逐元素计算tanh
+namespace NsTanh
+{
+struct ElementFunc
+{
+    template<typename TElem>
+    TElem operator()(TElem a) const
+    {
+        return static_cast<TElem>(std::tanh(a));
+    }
+};
+} // namespace NsTanh
+
+template<>
+struct OpSeq_<UnaryOpTags::Tanh>
+{
+    using type = OpSeqContainer<CaseFixedElementwise<NsTanh::ElementFunc>, CaseElementwise<NsTanh::ElementFunc>>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
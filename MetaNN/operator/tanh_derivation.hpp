@@ -1,6 +1,8 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/elementwise.hpp>
+#include <data/numeric_policy.hpp>
 
 namespace MetaNN
 {
@@ -9,6 +11,7 @@ namespace MetaNN
 // 支持类型：
 //      矩阵与矩阵
 //      矩阵列表与矩阵列表
+// data1为反向传播的梯度，data2为tanh的输出，结果为data1 * (1 - data2 * data2)
 
 template<typename T1, typename T2>
 class OpTanhDerivation
@@ -33,4 +36,25 @@ auto tanhDerivation(T1&& data1, T2&& data2)
     return OpTanhDerivation<T1, T2>::eval(std::forward<T1>(data1), std::forward<T2>(data2));
 }
 
+// 求值：逐元素计算，16位浮点元素在累加类型中计算后再舍入
+namespace NsTanhDerivation
+{
+struct ElementFunc
+{
+    template<typename TElem>
+    TElem operator()(TElem grad, TElem out) const
+    {
+        using AccType = AccumulateType<TElem, DeviceTags::CPU>;
+        const AccType y = static_cast<AccType>(out);
+        return static_cast<TElem>(static_cast<AccType>(grad) * (1 - y * y));
+    }
+};
+} // namespace NsTanhDerivation
+
+template<>
+struct OpSeq_<BinaryOpTags::TanhDerivation>
+{
+    using type = OpSeqContainer<CaseFixedElementwise<NsTanhDerivation::ElementFunc>, CaseElementwise<NsTanhDerivation::ElementFunc>>;
+};
+
 } // namespace MetaNN
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <operator/operators.hpp>
+#include <evaluate/evaluate.hpp>
 
 namespace MetaNN
 {
@@ -75,4 +76,25 @@ auto transpose(T&& data)
     return OpTranspose<T>::eval(std::forward<T>(data));
 }
 
+// 求值：动态形状的矩阵与矩阵列表得到共享存储的转置视图，不复制元素；编译期形状的矩阵复制为转置后的编译期形状矩阵
+// 分块矩阵逐块转置，复制为转置后的分块矩阵
+namespace NsTranspose
+{
+struct CaseTransposeView
+{
+    template<typename T>
+        requires requires(const EvalResult<T>& data) { data.transpose(); }
+    static auto eval(const T& data)
+    {
+        return evaluate(data).transpose();
+    }
+};
+} // namespace NsTranspose
+
+template<>
+struct OpSeq_<UnaryOpTags::Transpose>
+{
+    using type = OpSeqContainer<NsTranspose::CaseTransposeView>;
+};
+
 } // namespace MetaNN
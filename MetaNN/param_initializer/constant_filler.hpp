@@ -3,6 +3,7 @@
 #include <data/tags.hpp>
 #include <data/matrix/matrix.hpp>
 #include <stdexcept>
+#include <algorithm>
 
 namespace MetaNN
 {
@@ -13,23 +14,28 @@ namespace NsConstantFiller
 template<typename TElem>
 void fill(Matrix<TElem, DeviceTags::CPU>& mat, const double& val)
 {
-    if (!mat.avilableForWrite())
+    if (!mat.availableForWrite())
     {
         throw std::runtime_error("Matrix is string weight, can not fill in.");
     }
 
-    auto acc = lowerAccess(mat);
-    std::size_t row = mat.rowNum();
-    std::size_t col = mat.colNum();
-    std::size_t rowLen = acc.rowLen();
-    auto p = acc.mutableMemory();
-    for (std::size_t i = 0; i < row; i++)
+    auto view = mat.mutableView();
+    if (view.isRowContiguous())
     {
-        for (std::size_t j = 0; j < col; j ++)
+        for (auto row : view)
         {
-            p[j] = static_cast<TElem>(val);
+            std::ranges::fill(row, static_cast<TElem>(val));
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < view.rowNum(); i++)
+        {
+            for (std::size_t j = 0; j < view.colNum(); j++)
+            {
+                view(i, j) = static_cast<TElem>(val);
+            }
         }
-        p += rowLen;
     }
 }
 
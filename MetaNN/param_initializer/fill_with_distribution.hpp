@@ -20,19 +20,13 @@ void fillWithDistribution(Matrix<TElem, DeviceTags::CPU>& data, TDist& dist, TEn
         throw std::runtime_error("Matrix is sharing, can not fill-in.");
     }
 
-    auto acc = lowerAccess(data);
-    std::size_t row = data.rowNum();
-    std::size_t col = data.colNum();
-    std::size_t rowLen = acc.rowLen();
-    auto p = acc.rawMutableMemory();
-    
-    for (std::size_t i = 0; i < row; i++)
+    auto view = data.mutableView();
+    for (std::size_t i = 0; i < view.rowNum(); i++)
     {
-        for (std::size_t j = 0; j < col; j++)
+        for (std::size_t j = 0; j < view.colNum(); j++)
         {
-            p[i] = static_cast<TElem>(dist(engine));
+            view(i, j) = static_cast<TElem>(dist(engine));
         }
-        p += rowLen;
     }
 }
 
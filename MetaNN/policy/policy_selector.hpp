@@ -45,7 +45,7 @@ template<typename TCurPolicy, typename... TRestPolicies>
 struct MinorCheck_<PolicyContainer<TCurPolicy, TRestPolicies...>>
 {
     static constexpr bool current = (true && ... && (!std::is_same_v<typename TCurPolicy::MinorClass, typename TRestPolicies::MinorClass>));
-    static constexpr bool value = current && MinorCheck_<TRestPolicies...>::value;
+    static constexpr bool value = current && MinorCheck_<PolicyContainer<TRestPolicies...>>::value;
 };
 
 // 从策略容器中选择出所有相同MajorClass的策略对象
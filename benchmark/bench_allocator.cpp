@@ -0,0 +1,167 @@
+#include <data/allocator.hpp>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t IterationsPerThread = 200000;
+constexpr std::size_t LiveBlocks = 16;             // 每个线程同时存活的内存块数量
+constexpr std::size_t Shapes[] = {16, 100, 1024, 4096, 64 * 64};
+constexpr std::size_t HandoffBatch = 256;         // 跨线程释放时每次交换的内存块数量
+
+// 每个线程反复分配不同大小的内存块，只保留最近的LiveBlocks个
+template<typename TAllocator>
+void localChurn()
+{
+    std::vector<RawMemory> live(LiveBlocks);
+    for (std::size_t i = 0; i < IterationsPerThread; ++i)
+    {
+        std::size_t size = Shapes[i % std::size(Shapes)];
+        RawMemory& slot = live[i % LiveBlocks];
+        slot.release();
+        slot = TAllocator::allocate(size * sizeof(float), 64);
+        doNotOptimize(slot.ptr);
+    }
+    for (auto& raw : live)
+    {
+        raw.release();
+    }
+}
+
+// 分配的内存块交给相邻线程释放，模拟一个线程产生数据、另一个线程消费数据
+struct Mailbox
+{
+    std::mutex mutex;
+    std::vector<RawMemory> blocks;
+
+    void releaseAll()
+    {
+        for (auto& raw : blocks)
+        {
+            raw.release();
+        }
+        blocks.clear();
+    }
+};
+
+template<typename TAllocator>
+void crossThreadChurn(Mailbox& outbox, Mailbox& inbox)
+{
+    std::vector<RawMemory> produced;
+    std::vector<RawMemory> received;
+    produced.reserve(HandoffBatch);
+    for (std::size_t i = 0; i < IterationsPerThread; ++i)
+    {
+        std::size_t size = Shapes[i % std::size(Shapes)];
+        produced.push_back(TAllocator::allocate(size * sizeof(float), 64));
+        if (produced.size() == HandoffBatch)
+        {
+            {
+                std::lock_guard<std::mutex> lock(outbox.mutex);
+                std::move(produced.begin(), produced.end(), std::back_inserter(outbox.blocks));
+            }
+            produced.clear();
+            {
+                std::lock_guard<std::mutex> lock(inbox.mutex);
+                received.swap(inbox.blocks);
+            }
+            for (auto& raw : received) // 释放其他线程分配的内存块
+            {
+                raw.release();
+            }
+            received.clear();
+        }
+    }
+    for (auto& raw : produced)
+    {
+        raw.release();
+    }
+}
+
+// 返回所有线程合计的每秒分配次数（百万次）
+template<typename TAllocator>
+double run(std::size_t threadNum, bool crossThread)
+{
+    std::vector<Mailbox> mailboxes(threadNum);
+    double seconds = measureSeconds([&]() {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < threadNum; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                if (crossThread)
+                {
+                    crossThreadChurn<TAllocator>(mailboxes[t], mailboxes[(t + 1) % threadNum]);
+                }
+                else
+                {
+                    localChurn<TAllocator>();
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    });
+    for (auto& mailbox : mailboxes)
+    {
+        mailbox.releaseAll();
+    }
+    return threadNum * IterationsPerThread / seconds / 1e6;
+}
+
+template<typename TAllocator>
+void report(const std::string& name, const std::vector<std::size_t>& threadNums, bool crossThread)
+{
+    std::cout << std::left << std::setw(14) << name << std::right;
+    double base = 0;
+    for (std::size_t threadNum : threadNums)
+    {
+        double throughput = run<TAllocator>(threadNum, crossThread);
+        if (threadNum == 1)
+        {
+            base = throughput;
+        }
+        std::cout << std::setw(10) << std::fixed << std::setprecision(2) << throughput
+                  << " (" << std::setw(4) << std::setprecision(1) << throughput / base << "x)";
+    }
+    std::cout << "\n";
+}
+
+} // namespace
+
+void bench_allocator()
+{
+    printBenchmarkTitle("allocator: Mallocs/s over all threads (speedup vs 1 thread)");
+    std::size_t maxThreads = std::max<std::size_t>(4, std::thread::hardware_concurrency());
+    std::vector<std::size_t> threadNums;
+    for (std::size_t n = 1; n <= maxThreads; n *= 2)
+    {
+        threadNums.push_back(n);
+    }
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    for (bool crossThread : {false, true})
+    {
+        std::cout << (crossThread ? "-- freed by another thread\n" : "-- freed by the allocating thread\n");
+        std::cout << std::left << std::setw(14) << "threads" << std::right;
+        for (std::size_t threadNum : threadNums)
+        {
+            std::cout << std::setw(17) << threadNum;
+        }
+        std::cout << "\n";
+        report<Allocator<DeviceTags::CPU>>("heap", threadNums, crossThread);
+        report<PoolAllocator<DeviceTags::CPU>>("pool", threadNums, crossThread);
+        report<ThreadCacheAllocator<DeviceTags::CPU>>("thread cache", threadNums, crossThread);
+    }
+    auto stats = ThreadCacheAllocator<DeviceTags::CPU>::statistics();
+    std::cout << "thread cache hit rate: " << std::setprecision(3) << stats.hitRate()
+              << ", remote frees: " << stats.remoteFreeCount
+              << ", caches: " << stats.threadCacheCount << "\n";
+}
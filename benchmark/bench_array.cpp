@@ -0,0 +1,98 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/tanh.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/batch/array.hpp>
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 10;
+
+template<typename TFunc>
+double milliseconds(TFunc&& func)
+{
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            func();
+        }
+    });
+    return seconds / Iterations * 1e3;
+}
+
+Array<Matrix<float>> makeArray(std::size_t batchNum, std::size_t row, std::size_t col)
+{
+    Array<Matrix<float>> res(row, col);
+    res.reserve(batchNum);
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        Matrix<float> mat(row, col);
+        auto view = mat.mutableView();
+        for (std::size_t i = 0; i < row; ++i)
+        {
+            for (std::size_t j = 0; j < col; ++j)
+            {
+                view(i, j) = static_cast<float>((b + i * 3 + j) % 19) / 19.0f;
+            }
+        }
+        res.push_back(std::move(mat));
+    }
+    return res;
+}
+
+void run(std::size_t batchNum, std::size_t row, std::size_t col)
+{
+    const auto arr = makeArray(batchNum, row, col);
+    std::cout << batchNum << " * " << row << "*" << col << " ("
+              << batchNum * row * col * sizeof(float) / 1024 << " KB)\n" << std::fixed << std::setprecision(3);
+
+    // 逐个矩阵计算：每个元素一次求值，结果分散在各自的内存中
+    double perElement = milliseconds([&]() {
+        for (std::size_t b = 0; b < arr.size(); ++b)
+        {
+            auto res = evaluate(tanh(arr[b] + arr[b]));
+            doNotOptimize(res);
+        }
+    });
+    std::cout << "    per-matrix evaluation:  " << std::setw(8) << perElement << " ms\n";
+
+    // 每次都重新收集再按列表计算
+    double gathered = milliseconds([&]() {
+        auto packed = arr.gather(1);
+        auto res = evaluate(tanh(packed + packed));
+        doNotOptimize(res);
+    });
+    std::cout << "    gather + batched:       " << std::setw(8) << gathered << " ms\n";
+
+    // 收集结果缓存在数组中，之后的运算直接使用连续的列表
+    evaluate(arr);
+    double cached = milliseconds([&]() {
+        auto res = evaluate(tanh(arr + arr));
+        doNotOptimize(res);
+    });
+    std::cout << "    cached batched:         " << std::setw(8) << cached << " ms\n";
+
+    const std::size_t threadNum = std::max(1u, std::thread::hardware_concurrency());
+    double serial = milliseconds([&]() { auto res = arr.gather(1); doNotOptimize(res); });
+    double parallel = milliseconds([&]() { auto res = arr.gather(threadNum); doNotOptimize(res); });
+    std::cout << "    gather, 1 thread:       " << std::setw(8) << serial << " ms\n"
+              << "    gather, " << std::setw(2) << threadNum << " threads:     " << std::setw(8) << parallel << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+} // namespace
+
+void bench_array()
+{
+    printBenchmarkTitle("array: per-matrix evaluation -> contiguous gather cached in Array");
+    run(1024, 16, 16);
+    run(64, 256, 256);
+}
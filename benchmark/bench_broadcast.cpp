@@ -0,0 +1,57 @@
+#include <evaluate/evaluate.hpp>
+#include <evaluate/broadcast.hpp>
+#include <operator/add.hpp>
+#include <operator/dot.hpp>
+#include <data/scalar.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/trivial_matrix.hpp>
+#include <data/matrix/one_hot_vector.hpp>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 20;
+
+void run(std::size_t row, std::size_t col)
+{
+    std::cout << row << "*" << col << "\n";
+    auto mat = makeMatrix(row, col);
+    auto weight = makeMatrix(col, col);
+
+    // 稠密：每次迭代生成常量矩阵再计算；广播：平凡矩阵以广播视图参与计算
+    double dense = milliseconds(Iterations, [&]() {
+        auto constant = TrivialMatrix<float>(row, col, 0.5f).materialize();
+        auto res = evaluate(constant + mat);
+        doNotOptimize(res);
+    });
+    double symbolic = milliseconds(Iterations, [&]() {
+        auto res = evaluate(Scalar<float>(0.5f) + mat);
+        doNotOptimize(res);
+    });
+    printComparison("scalar + matrix", dense, symbolic);
+
+    TrivialMatrix<float> trivial(row, col, 0.5f);
+    auto trivialDense = trivial.materialize();
+    dense = milliseconds(Iterations, [&]() { auto res = evaluate(dot(trivialDense, weight)); doNotOptimize(res); });
+    symbolic = milliseconds(Iterations, [&]() { auto res = evaluate(dot(trivial, weight)); doNotOptimize(res); });
+    printComparison("dot(trivial, matrix)", dense, symbolic);
+
+    OneHotVector<float> hot(col, col / 2);
+    auto hotDense = hot.materialize();
+    dense = milliseconds(Iterations, [&]() { auto res = evaluate(dot(hotDense, weight)); doNotOptimize(res); });
+    symbolic = milliseconds(Iterations, [&]() { auto res = evaluate(dot(hot, weight)); doNotOptimize(res); });
+    printComparison("dot(one-hot, matrix)", dense, symbolic);
+}
+
+} // namespace
+
+void bench_broadcast()
+{
+    printBenchmarkTitle("broadcast: dense constant matrices -> symbolic trivial / one-hot operands");
+    run(256, 256);
+    run(1024, 1024);
+}
@@ -0,0 +1,84 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/dot.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <data/batch/duplicate.hpp>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 10;
+
+using BatchType = Batch<float, DeviceTags::CPU, CategoryTags::Matrix>;
+
+// 把矩阵复制batchNum份，作为朴素的重复列表求值方式的参照
+BatchType copyBatch(const Matrix<float>& mat, std::size_t batchNum)
+{
+    BatchType res(batchNum, mat.rowNum(), mat.colNum());
+    auto dest = res.mutableView();
+    const auto src = mat.view();
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        for (std::size_t i = 0; i < mat.rowNum(); ++i)
+        {
+            for (std::size_t j = 0; j < mat.colNum(); ++j)
+            {
+                dest(b, i, j) = src(i, j);
+            }
+        }
+    }
+    return res;
+}
+
+void run(std::size_t batchNum, std::size_t row, std::size_t dim)
+{
+    std::cout << batchNum << " * " << row << "*" << dim << ", weight " << dim << "*" << dim << "\n";
+    BatchType input(batchNum, row, dim);
+    auto inputView = input.mutableView();
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        for (std::size_t i = 0; i < row; ++i)
+        {
+            for (std::size_t j = 0; j < dim; ++j)
+            {
+                inputView(b, i, j) = static_cast<float>((b + i + j) % 7) / 7.0f;
+            }
+        }
+    }
+    const auto weight = makeMatrix(dim, dim);
+    const auto bias = makeMatrix(row, dim);
+
+    // 复制：求值时把权重复制batchNum份；共享：重复列表求值为矩阵间隔为0的列表
+    double copied = milliseconds(Iterations, [&]() {
+        auto res = evaluate(dot(input, copyBatch(weight, batchNum)));
+        doNotOptimize(res);
+    });
+    double shared = milliseconds(Iterations, [&]() { auto res = evaluate(dot(input, weight)); doNotOptimize(res); });
+    printComparison("dot(batch, W)", copied, shared);
+
+    // 转置的权重列不连续：复制后的每个矩阵都按列访问，共享时只转换一次为行连续的矩阵
+    copied = milliseconds(Iterations, [&]() {
+        auto res = evaluate(dot(input, copyBatch(weight, batchNum).transpose()));
+        doNotOptimize(res);
+    });
+    shared = milliseconds(Iterations, [&]() { auto res = evaluate(dot(input, weight.transpose())); doNotOptimize(res); });
+    printComparison("dot(batch, transpose(W))", copied, shared);
+
+    copied = milliseconds(Iterations, [&]() { auto res = evaluate(copyBatch(bias, batchNum) + input); doNotOptimize(res); });
+    shared = milliseconds(Iterations, [&]() { auto res = evaluate(bias + input); doNotOptimize(res); });
+    printComparison("bias + batch", copied, shared);
+}
+
+} // namespace
+
+void bench_duplicate()
+{
+    printBenchmarkTitle("duplicate: copied matrix per batch -> stride-0 shared batch");
+    run(64, 16, 256);
+    run(256, 4, 512);
+}
@@ -0,0 +1,64 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/element_mul.hpp>
+#include <operator/dot.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/fixed_matrix.hpp>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 2000000;
+
+template<typename TMatrix>
+void fill(TMatrix& mat, float base)
+{
+    for (std::size_t i = 0; i < mat.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < mat.colNum(); ++j)
+        {
+            mat.setValue(i, j, base + 0.001f * (i * mat.colNum() + j));
+        }
+    }
+}
+
+// 门控形式的小矩阵计算：acc = acc * w + b，每次迭代依赖上一次的结果
+template<std::size_t N, typename TMatrix>
+double gatesPerSecond(TMatrix w, TMatrix b)
+{
+    fill(w, 0.01f);
+    fill(b, 0.5f);
+    TMatrix acc = b;
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            acc = evaluate(dot(acc, w) + b);
+            doNotOptimize(acc);
+        }
+    });
+    return Iterations / seconds / 1e6;
+}
+
+template<std::size_t N>
+void compare()
+{
+    double dynamicRate = gatesPerSecond<N>(Matrix<float>(N, N), Matrix<float>(N, N));
+    double fixedRate = gatesPerSecond<N>(FixedMatrix<float, N, N>(), FixedMatrix<float, N, N>());
+    std::cout << N << "*" << N << "  dynamic: " << std::fixed << std::setprecision(2) << std::setw(8) << dynamicRate
+              << "  fixed: " << std::setw(8) << fixedRate
+              << "  speedup: " << std::setprecision(1) << fixedRate / dynamicRate << "x\n";
+}
+
+} // namespace
+
+void bench_fixed_matrix()
+{
+    printBenchmarkTitle("fixed_matrix: evaluate(dot(acc, w) + b), M/s");
+    compare<2>();
+    compare<4>();
+    compare<8>();
+}
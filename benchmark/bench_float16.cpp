@@ -0,0 +1,54 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/dot.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/float16.hpp>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 5;
+
+template<typename TElem>
+void run(const char* name)
+{
+    auto big1 = makeMatrix<TElem>(2048, 2048);
+    auto big2 = makeMatrix<TElem>(2048, 2048);
+    double addSeconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            auto res = evaluate(big1 + big2);
+            doNotOptimize(res);
+        }
+    }) / Iterations;
+
+    auto mat1 = makeMatrix<TElem>(256, 512);
+    auto mat2 = makeMatrix<TElem>(512, 256);
+    double dotSeconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            auto res = evaluate(dot(mat1, mat2));
+            doNotOptimize(res);
+        }
+    }) / Iterations;
+
+    std::cout << std::setw(10) << name << "  bytes/matrix: " << std::setw(9) << 2048 * 2048 * sizeof(TElem)
+              << std::fixed << std::setprecision(3)
+              << "  add 2048*2048: " << std::setw(8) << addSeconds * 1e3 << " ms"
+              << "  dot 256*512*256: " << std::setw(8) << dotSeconds * 1e3 << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+} // namespace
+
+void bench_float16()
+{
+    printBenchmarkTitle("float16: storage size and evaluation time by element type");
+    run<float>("float");
+    run<Float16>("Float16");
+    run<BFloat16>("BFloat16");
+}
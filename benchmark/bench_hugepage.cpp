@@ -0,0 +1,55 @@
+#include <data/allocator.hpp>
+#include <cstdint>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t BufferBytes = std::size_t(256) << 20;
+constexpr std::size_t Accesses = 20000000;
+
+// 在大缓冲区上做随机读写，访问跨越大量页面，TLB缺失占主要开销
+double randomAccessPerSecond(const RawMemory& raw)
+{
+    float* data = static_cast<float*>(raw.ptr);
+    std::size_t count = BufferBytes / sizeof(float);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        data[i] = 1.0f;
+    }
+    std::uint64_t state = 88172645463325252ull;
+    float sum = 0;
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Accesses; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            sum += data[state % count];
+        }
+    });
+    doNotOptimize(sum);
+    return Accesses / seconds / 1e6;
+}
+
+} // namespace
+
+void bench_hugepage()
+{
+    using HugePages = HugePageAllocator<DeviceTags::CPU>;
+    printBenchmarkTitle("hugepage: random access over 256MB, M/s");
+
+    RawMemory heap = Allocator<DeviceTags::CPU>::allocate(BufferBytes, 64);
+    std::cout << "heap:                       " << std::fixed << std::setprecision(2) << randomAccessPerSecond(heap) << "\n";
+    heap.release();
+
+    HugePages::resetStatistics();
+    RawMemory huge = HugePages::allocate(BufferBytes, 64, HugePages::HugePageSize, false);
+    std::cout << "transparent huge pages:     " << std::fixed << std::setprecision(2) << randomAccessPerSecond(huge) << "\n";
+    std::cout << "  requested huge page MB:   " << HugePages::statistics().hugePageBytes() / (1 << 20)
+              << ", resident THP MB: " << HugePages::residentTransparentBytes() / (1 << 20) << "\n";
+    huge.release();
+}
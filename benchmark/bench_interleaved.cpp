@@ -0,0 +1,79 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/element_mul.hpp>
+#include <operator/tanh.hpp>
+#include <operator/dot.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <data/batch/interleaved_batch.hpp>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 20;
+
+using BatchType = Batch<float, DeviceTags::CPU, CategoryTags::Matrix>;
+
+BatchType makeBatch(std::size_t batchNum, std::size_t row, std::size_t col)
+{
+    BatchType res(batchNum, row, col);
+    auto view = res.mutableView();
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        for (std::size_t i = 0; i < row; ++i)
+        {
+            for (std::size_t j = 0; j < col; ++j)
+            {
+                view(b, i, j) = static_cast<float>((b + i * 3 + j) % 11) / 11.0f;
+            }
+        }
+    }
+    return res;
+}
+
+// batchNum个dim * dim的小矩阵
+void run(std::size_t batchNum, std::size_t dim)
+{
+    std::cout << batchNum << " * " << dim << "*" << dim << "\n";
+    const auto a = makeBatch(batchNum, dim, dim);
+    const auto b = makeBatch(batchNum, dim, dim);
+    const auto interA = makeInterleaved(a);
+    const auto interB = makeInterleaved(b);
+    Matrix<float> weight(dim, dim);
+    for (auto row : weight.mutableView())
+    {
+        for (std::size_t j = 0; j < row.size(); ++j)
+        {
+            row[j] = static_cast<float>(j % 5) * 0.2f;
+        }
+    }
+
+    double t1 = milliseconds(Iterations, [&]() { auto res = evaluate(tanh(a * b + a)); doNotOptimize(res); });
+    double t2 = milliseconds(Iterations, [&]() { auto res = evaluate(tanh(interA * interB + interA)); doNotOptimize(res); });
+    printComparison("tanh(a * b + a)", t1, t2);
+    t1 = milliseconds(Iterations, [&]() { auto res = evaluate(dot(a, b)); doNotOptimize(res); });
+    t2 = milliseconds(Iterations, [&]() { auto res = evaluate(dot(interA, interB)); doNotOptimize(res); });
+    printComparison("dot(a, b)", t1, t2);
+    t1 = milliseconds(Iterations, [&]() { auto res = evaluate(dot(a, weight)); doNotOptimize(res); });
+    t2 = milliseconds(Iterations, [&]() { auto res = evaluate(dot(interA, weight)); doNotOptimize(res); });
+    printComparison("dot(a, W)", t1, t2);
+    t1 = milliseconds(Iterations, [&]() { auto res = makeInterleaved(a); doNotOptimize(res); });
+    t2 = milliseconds(Iterations, [&]() { auto res = makeDense(interA); doNotOptimize(res); });
+    std::cout << "    conversion: to interleaved " << std::fixed << std::setprecision(3) << t1
+              << " ms, back " << t2 << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+} // namespace
+
+void bench_interleaved()
+{
+    printBenchmarkTitle("interleaved: batch-major -> batch-interleaved layout for small matrices");
+    run(4096, 3);
+    run(4096, 4);
+    run(1024, 8);
+}
@@ -0,0 +1,108 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/element_mul.hpp>
+#include <operator/tanh.hpp>
+#include <data/batch/batch.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 10;
+
+using BatchType = Batch<float, DeviceTags::CPU, CategoryTags::Matrix>;
+
+BatchType makeBatch(std::size_t batchNum, std::size_t row, std::size_t col, float scale)
+{
+    BatchType res(batchNum, row, col);
+    auto view = res.mutableView();
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        for (auto rowSpan : view[b])
+        {
+            for (std::size_t j = 0; j < rowSpan.size(); ++j)
+            {
+                rowSpan[j] = scale * static_cast<float>((b + j) % 17) / 17.0f;
+            }
+        }
+    }
+    return res;
+}
+
+template<typename TFunc>
+double milliseconds(TFunc&& func)
+{
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            func();
+        }
+    });
+    return seconds / Iterations * 1e3;
+}
+
+// 每一步运算都生成与输入同样大小的中间结果
+auto step(const BatchType& a, const BatchType& b)
+{
+    return evaluate(tanh(evaluate(evaluate(a * b) + a)));
+}
+
+void run(std::size_t batchNum, std::size_t row, std::size_t col)
+{
+    auto a = makeBatch(batchNum, row, col, 1.0f);
+    auto b = makeBatch(batchNum, row, col, 0.5f);
+    const std::size_t bytes = batchNum * row * col * sizeof(float);
+    std::cout << batchNum << " * " << row << "*" << col << " (" << bytes / 1024 << " KB per operand)\n"
+              << std::fixed << std::setprecision(3);
+
+    double whole = milliseconds([&]() { auto res = step(a, b); doNotOptimize(res); });
+    std::cout << "    whole batch:          " << std::setw(8) << whole << " ms\n";
+
+    // 每个小批次约256KB，中间结果留在缓存中
+    const std::size_t partNum = std::max<std::size_t>(1, bytes / (256 * 1024));
+    double micro = milliseconds([&]() {
+        auto partsA = splitBatch(a, partNum);
+        auto partsB = splitBatch(b, partNum);
+        for (std::size_t i = 0; i < partNum; ++i)
+        {
+            auto res = step(partsA[i], partsB[i]);
+            doNotOptimize(res);
+        }
+    });
+    std::cout << "    " << std::setw(4) << partNum << " micro-batches:   " << std::setw(8) << micro << " ms\n";
+
+    const std::size_t threadNum = std::max(1u, std::thread::hardware_concurrency());
+    double parallel = milliseconds([&]() {
+        auto partsA = splitBatch(a, threadNum);
+        auto partsB = splitBatch(b, threadNum);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < threadNum; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                auto res = step(partsA[i], partsB[i]);
+                doNotOptimize(res);
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+    });
+    std::cout << "    " << std::setw(4) << threadNum << " threads:         " << std::setw(8) << parallel << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+} // namespace
+
+void bench_micro_batch()
+{
+    printBenchmarkTitle("micro_batch: whole batch -> zero-copy sub-batches (sequential / threads)");
+    run(256, 64, 64);
+    run(64, 256, 256);
+}
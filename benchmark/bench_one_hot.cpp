@@ -0,0 +1,73 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/dot.hpp>
+#include <operator/negative_log_likelihood.hpp>
+#include <operator/negative_log_likelihood_derivation.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <data/batch/batch_one_hot_vector.hpp>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 20;
+
+// batchNum个标签，类别数（词表大小）为classNum，嵌入维度为dim
+void run(std::size_t batchNum, std::size_t classNum, std::size_t dim)
+{
+    std::cout << "batch " << batchNum << ", classes " << classNum << ", dim " << dim << "\n";
+    std::vector<std::size_t> positions(batchNum);
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        positions[b] = (b * 7919) % classNum;
+    }
+    BatchOneHotVector<float> labels(classNum, positions);
+    // 稠密的标签与独热向量列表的稠密形式相同，但作为普通的矩阵列表参与计算
+    Batch<float, DeviceTags::CPU, CategoryTags::Matrix> dense = labels.materialize();
+
+    Matrix<float> weight(classNum, dim);
+    for (auto row : weight.mutableView())
+    {
+        for (std::size_t j = 0; j < row.size(); ++j)
+        {
+            row[j] = static_cast<float>(j % 13) * 0.1f;
+        }
+    }
+    Batch<float, DeviceTags::CPU, CategoryTags::Matrix> pred(batchNum, 1, classNum);
+    auto predView = pred.mutableView();
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        for (std::size_t j = 0; j < classNum; ++j)
+        {
+            predView(b, 0, j) = 1.0f / static_cast<float>(classNum);
+        }
+    }
+    Batch<float, DeviceTags::CPU, CategoryTags::Scalar> grad(batchNum);
+    for (auto& g : grad.mutableView())
+    {
+        g = 1.0f;
+    }
+
+    double t1 = milliseconds(Iterations, [&]() { auto res = evaluate(dot(dense, weight)); doNotOptimize(res); });
+    double t2 = milliseconds(Iterations, [&]() { auto res = evaluate(dot(labels, weight)); doNotOptimize(res); });
+    printComparison("dot (embedding)", t1, t2);
+    t1 = milliseconds(Iterations, [&]() { auto res = evaluate(negativeLogLikelihood(dense, pred)); doNotOptimize(res); });
+    t2 = milliseconds(Iterations, [&]() { auto res = evaluate(negativeLogLikelihood(labels, pred)); doNotOptimize(res); });
+    printComparison("negativeLogLikelihood", t1, t2);
+    t1 = milliseconds(Iterations, [&]() { auto res = evaluate(negativeLogLikelihoodDerivation(grad, dense, pred)); doNotOptimize(res); });
+    t2 = milliseconds(Iterations, [&]() { auto res = evaluate(negativeLogLikelihoodDerivation(grad, labels, pred)); doNotOptimize(res); });
+    printComparison("derivation", t1, t2);
+}
+
+} // namespace
+
+void bench_one_hot()
+{
+    printBenchmarkTitle("one_hot: dense one-hot batch -> BatchOneHotVector");
+    run(256, 1000, 128);
+    run(64, 30000, 64);
+}
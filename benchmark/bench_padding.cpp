@@ -0,0 +1,85 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/dot.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/lower_access.hpp>
+#include <facility/data_copy.hpp>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+// unsigned的矩阵每行填充到缓存行（64字节，16个元素）
+template<>
+struct MetaNN::DataMemoryPolicy_<unsigned, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PRowAlignmentIs<64>>;
+};
+
+namespace
+{
+
+constexpr std::size_t Iterations = 20;
+
+// 行长度为rowLen的矩阵，rowLen等于列数时各行紧密排列
+Matrix<unsigned> makeMatrix(std::size_t row, std::size_t col, std::size_t rowLen)
+{
+    Matrix<unsigned> res(ContinuousMemory<unsigned, DeviceTags::CPU>(row * rowLen, "Matrix"), row, col, rowLen);
+    auto view = res.mutableView();
+    for (std::size_t i = 0; i < row; ++i)
+    {
+        for (std::size_t j = 0; j < col; ++j)
+        {
+            view(i, j) = static_cast<unsigned>(i + j);
+        }
+    }
+    return res;
+}
+
+template<typename TFunc>
+double milliseconds(TFunc&& func)
+{
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            func();
+        }
+    });
+    return seconds / Iterations * 1e3;
+}
+
+void run(std::size_t row, std::size_t col)
+{
+    const std::size_t padded = paddedRowLen<unsigned, DeviceTags::CPU>(col);
+    double times[2][3];
+    for (std::size_t useDense = 0; useDense < 2; ++useDense)
+    {
+        const std::size_t rowLen = useDense ? col : padded;
+        auto mat1 = makeMatrix(row, col, rowLen);
+        auto mat2 = makeMatrix(row, col, rowLen);
+        auto dest = makeMatrix(row, col, rowLen);
+        auto weight = makeMatrix(col, col, rowLen);
+        times[useDense][0] = milliseconds([&]() { dataCopy(mat1, dest); doNotOptimize(dest); });
+        times[useDense][1] = milliseconds([&]() { auto res = evaluate(mat1 + mat2); doNotOptimize(res); });
+        times[useDense][2] = milliseconds([&]() { auto res = evaluate(dot(mat1, weight)); doNotOptimize(res); });
+    }
+    std::cout << std::setw(5) << row << "*" << std::setw(4) << col << " (padded rowLen " << std::setw(4) << padded << ")"
+              << std::fixed << std::setprecision(3);
+    const char* names[] = {"copy", "add", "dot"};
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        std::cout << "  " << names[k] << ": " << std::setw(7) << times[1][k] << " -> " << std::setw(7) << times[0][k];
+    }
+    std::cout << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+} // namespace
+
+void bench_padding()
+{
+    printBenchmarkTitle("padding: dense rows -> rows padded to 64 bytes (unsigned elements)");
+    run(4096, 17);
+    run(1024, 250);
+    run(512, 1001);
+}
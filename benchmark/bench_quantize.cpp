@@ -0,0 +1,92 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/dot.hpp>
+#include <operator/quantize.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/quantized_matrix.hpp>
+#include <random>
+#include <cmath>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t BatchRows = 256;
+constexpr std::size_t InputNum = 1024;
+constexpr std::size_t OutputNum = 1024;
+constexpr std::size_t Iterations = 5;
+
+Matrix<float> makeRandom(std::size_t row, std::size_t col, float stddev, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> dist(0.0f, stddev);
+    Matrix<float> res(row, col);
+    for (auto r : res.mutableView())
+    {
+        for (auto& val : r)
+        {
+            val = dist(gen);
+        }
+    }
+    return res;
+}
+
+template<typename TFunc>
+double milliseconds(TFunc&& func)
+{
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            auto res = func();
+            doNotOptimize(res);
+        }
+    });
+    return seconds / Iterations * 1e3;
+}
+
+} // namespace
+
+void bench_quantize()
+{
+    printBenchmarkTitle("quantize: dot(input 256*1024, weight 1024*1024), float vs int8");
+    auto input = makeRandom(BatchRows, InputNum, 1.0f, 1);
+    auto weight = makeRandom(InputNum, OutputNum, 0.05f, 2);
+    // 权重离线量化，输入在每次计算时按行动态量化
+    auto quantizedWeight = makeQuantized(weight);
+    auto quantizedInput = makeQuantized<QuantizeTags::PerRow>(input);
+
+    double floatTime = milliseconds([&]() { return evaluate(dot(input, weight)); });
+    double kernelTime = milliseconds([&]() { return evaluate(dot(quantizedInput, quantizedWeight)); });
+    double dynamicTime = milliseconds([&]() { return evaluate(dot(quantize<QuantizeTags::PerRow>(input), quantizedWeight)); });
+
+    auto ref = evaluate(dot(input, weight));
+    auto res = evaluate(dot(quantize<QuantizeTags::PerRow>(input), quantizedWeight));
+    double maxAbs = 0;
+    double maxErr = 0;
+    double sqErr = 0;
+    for (std::size_t i = 0; i < BatchRows; ++i)
+    {
+        for (std::size_t j = 0; j < OutputNum; ++j)
+        {
+            double err = std::abs(double(res(i, j)) - ref(i, j));
+            maxAbs = std::max(maxAbs, std::abs(double(ref(i, j))));
+            maxErr = std::max(maxErr, err);
+            sqErr += err * err;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "weight bytes   float: " << InputNum * OutputNum * sizeof(float)
+              << "  int8: " << InputNum * OutputNum * sizeof(std::int8_t) << "\n"
+              << "float dot:                  " << std::setw(8) << floatTime << " ms\n"
+              << "int8 dot (pre-quantized):   " << std::setw(8) << kernelTime << " ms  speedup: "
+              << std::setprecision(2) << floatTime / kernelTime << "x\n" << std::setprecision(3)
+              << "int8 dot (quantize input):  " << std::setw(8) << dynamicTime << " ms  speedup: "
+              << std::setprecision(2) << floatTime / dynamicTime << "x\n"
+              << std::setprecision(5)
+              << "error vs float: max " << maxErr << " (" << maxErr / maxAbs * 100 << "% of max |result|), rms "
+              << std::sqrt(sqErr / (BatchRows * OutputNum)) << "\n";
+    std::cout.unsetf(std::ios::fixed);
+}
@@ -0,0 +1,77 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/element_mul.hpp>
+#include <operator/tanh.hpp>
+#include <operator/dot.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/batch/batch.hpp>
+#include <data/batch/ragged_batch.hpp>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t Iterations = 10;
+
+using BatchType = Batch<float, DeviceTags::CPU, CategoryTags::Matrix>;
+
+// batchNum个序列，长度在maxLen / 8到maxLen之间变化，每个位置dim维
+void run(std::size_t batchNum, std::size_t maxLen, std::size_t dim)
+{
+    std::vector<std::size_t> rowNums(batchNum);
+    std::size_t totalRowNum = 0;
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        rowNums[b] = maxLen / 8 + (b * 37) % (maxLen - maxLen / 8 + 1);
+        totalRowNum += rowNums[b];
+    }
+    std::cout << batchNum << " sequences, " << maxLen << " rows max (" << totalRowNum * 100 / (batchNum * maxLen)
+              << "% filled), dim " << dim << "\n";
+
+    BatchType padded(batchNum, maxLen, dim);
+    auto view = padded.mutableView();
+    for (std::size_t b = 0; b < batchNum; ++b)
+    {
+        for (std::size_t i = 0; i < maxLen; ++i)
+        {
+            for (std::size_t j = 0; j < dim; ++j)
+            {
+                view(b, i, j) = i < rowNums[b] ? static_cast<float>((b + i * 3 + j) % 13) / 13.0f : 0.0f;
+            }
+        }
+    }
+    const auto ragged = makeRagged(padded, rowNums);
+    Matrix<float> weight(dim, dim);
+    for (auto row : weight.mutableView())
+    {
+        for (std::size_t j = 0; j < row.size(); ++j)
+        {
+            row[j] = static_cast<float>(j % 7) / 7.0f - 0.5f;
+        }
+    }
+
+    double t1 = milliseconds(Iterations, [&]() { auto res = evaluate(tanh(padded * padded + padded)); doNotOptimize(res); });
+    double t2 = milliseconds(Iterations, [&]() { auto res = evaluate(tanh(ragged * ragged + ragged)); doNotOptimize(res); });
+    printComparison("tanh(x * x + x)", t1, t2);
+    t1 = milliseconds(Iterations, [&]() { auto res = evaluate(dot(padded, weight)); doNotOptimize(res); });
+    t2 = milliseconds(Iterations, [&]() { auto res = evaluate(dot(ragged, weight)); doNotOptimize(res); });
+    printComparison("dot(x, W)", t1, t2);
+    t1 = milliseconds(Iterations, [&]() { auto res = makeRagged(padded, rowNums); doNotOptimize(res); });
+    t2 = milliseconds(Iterations, [&]() { auto res = makePadded(ragged); doNotOptimize(res); });
+    std::cout << "    conversion: to ragged " << std::fixed << std::setprecision(3) << t1
+              << " ms, back " << t2 << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+} // namespace
+
+void bench_ragged()
+{
+    printBenchmarkTitle("ragged: padded batch -> ragged batch for variable-length sequences");
+    run(64, 256, 128);
+    run(256, 64, 256);
+}
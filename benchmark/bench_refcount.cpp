@@ -0,0 +1,43 @@
+#include <data/matrix/matrix.hpp>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+// int仅在单线程中使用，选择非原子引用计数，float使用默认的原子引用计数
+template<>
+struct MetaNN::DataMemoryPolicy_<int, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PNonAtomicRefCount>;
+};
+
+namespace
+{
+
+constexpr std::size_t Iterations = 10000000;
+
+// 反复创建子矩阵视图与底层访问对象，每次都会增加并减少引用计数
+template<typename TElem>
+double viewsPerSecond()
+{
+    Matrix<TElem> mat(16, 16);
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            auto sub = mat.subMatrix(i % 8, 16, 0, 16);
+            auto acc = lowerAccess(sub);
+            doNotOptimize(acc.rawMemory());
+        }
+    });
+    return Iterations / seconds / 1e6;
+}
+
+} // namespace
+
+void bench_refcount()
+{
+    printBenchmarkTitle("refcount: subMatrix + lowerAccess views, M/s");
+    std::cout << "atomic refcount (float):    " << std::fixed << std::setprecision(2) << viewsPerSecond<float>() << "\n";
+    std::cout << "non-atomic refcount (int):  " << std::fixed << std::setprecision(2) << viewsPerSecond<int>() << "\n";
+}
@@ -0,0 +1,69 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/dot.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/sparse_matrix.hpp>
+#include <random>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t BatchRows = 256;
+constexpr std::size_t FeatureNum = 4096;
+constexpr std::size_t HiddenNum = 128;
+constexpr std::size_t Iterations = 5;
+
+// 每行约有density * FeatureNum个非零特征
+Matrix<float> makeFeatures(double density)
+{
+    std::mt19937 gen(42);
+    std::bernoulli_distribution hit(density);
+    Matrix<float> res(BatchRows, FeatureNum);
+    for (std::size_t i = 0; i < BatchRows; ++i)
+    {
+        for (std::size_t j = 0; j < FeatureNum; ++j)
+        {
+            res.setValue(i, j, hit(gen) ? 1.0f : 0.0f);
+        }
+    }
+    return res;
+}
+
+template<typename TFeature>
+double milliseconds(const TFeature& features, const Matrix<float>& weight)
+{
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            auto res = evaluate(dot(features, weight));
+            doNotOptimize(res);
+        }
+    });
+    return seconds / Iterations * 1e3;
+}
+
+} // namespace
+
+void bench_sparse()
+{
+    printBenchmarkTitle("sparse: dot(features 256*4096, weight 4096*128), ms");
+    Matrix<float> weight(FeatureNum, HiddenNum);
+    for (auto row : weight.mutableView())
+    {
+        std::ranges::fill(row, 0.5f);
+    }
+    for (double density : {0.001, 0.01, 0.1})
+    {
+        auto dense = makeFeatures(density);
+        auto sparse = makeSparse(dense);
+        double denseTime = milliseconds(dense, weight);
+        double sparseTime = milliseconds(sparse, weight);
+        std::cout << "density " << std::setw(5) << density << "  dense: " << std::fixed << std::setprecision(3)
+                  << std::setw(8) << denseTime << "  sparse: " << std::setw(8) << sparseTime
+                  << "  speedup: " << std::setprecision(1) << denseTime / sparseTime << "x\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+}
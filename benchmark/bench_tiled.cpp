@@ -0,0 +1,69 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/dot.hpp>
+#include <operator/transpose.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/tiled_matrix.hpp>
+#include <facility/data_copy.hpp>
+
+#include "benchmark.hpp"
+
+using namespace MetaNN;
+
+namespace
+{
+
+constexpr std::size_t N = 1024;
+constexpr std::size_t Iterations = 3;
+
+// 输出每次执行的毫秒数与缓存未命中次数
+template<typename TFunc>
+void report(const char* name, CacheMissCounter& counter, TFunc&& func)
+{
+    std::uint64_t misses = 0;
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            misses += counter.measure(func);
+        }
+    });
+    std::cout << std::setw(30) << std::left << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << seconds / Iterations * 1e3 << " ms";
+    if (counter.valid())
+    {
+        std::cout << std::setw(14) << misses / Iterations << " cache misses";
+    }
+    std::cout << "\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+} // namespace
+
+void bench_tiled()
+{
+    printBenchmarkTitle("tiled: row-major vs 64*64 tiles, 1024*1024 float");
+    CacheMissCounter counter;
+    if (!counter.valid())
+    {
+        std::cout << "(hardware cache miss counter unavailable, showing time only)\n";
+    }
+    auto mat1 = makeMatrix(N, N);
+    auto mat2 = makeMatrix(N, N);
+    auto tiled1 = makeTiled(mat1);
+    auto tiled2 = makeTiled(mat2);
+
+    report("row-major dot(a, b)", counter, [&]() { auto res = evaluate(dot(mat1, mat2)); doNotOptimize(res); });
+    report("tiled     dot(a, b)", counter, [&]() { auto res = evaluate(dot(tiled1, tiled2)); doNotOptimize(res); });
+    report("row-major dot(a^T, b)", counter, [&]() { auto res = evaluate(dot(transpose(mat1), mat2)); doNotOptimize(res); });
+    report("tiled     dot(a^T, b)", counter, [&]() { auto res = evaluate(dot(transpose(tiled1), tiled2)); doNotOptimize(res); });
+    report("row-major dot(a, b^T)", counter, [&]() { auto res = evaluate(dot(mat1, transpose(mat2))); doNotOptimize(res); });
+    report("tiled     dot(a, b^T)", counter, [&]() { auto res = evaluate(dot(tiled1, transpose(tiled2))); doNotOptimize(res); });
+    // 转置并复制为新的矩阵：按行存储时读或写总有一方跨行访问
+    report("row-major transpose (copy)", counter, [&]() {
+        Matrix<float> res(N, N);
+        dataCopy(mat1.transpose(), res);
+        doNotOptimize(res);
+    });
+    report("tiled     transpose", counter, [&]() { auto res = tiled1.transpose(); doNotOptimize(res); });
+    report("conversion to tiled", counter, [&]() { auto res = makeTiled(mat1); doNotOptimize(res); });
+    report("conversion to row-major", counter, [&]() { auto res = makeDense(tiled1); doNotOptimize(res); });
+}
@@ -0,0 +1,46 @@
+#include "benchmark.hpp"
+#include <string>
+#include <map>
+#include <functional>
+
+// 不带参数运行全部基准测试，否则只运行参数指定的基准测试
+int main(int argc, char const *argv[])
+{
+    std::map<std::string, std::function<void()>> benchmarks = {
+        {"allocator", bench_allocator},
+        {"array", bench_array},
+        {"broadcast", bench_broadcast},
+        {"duplicate", bench_duplicate},
+        {"fixed_matrix", bench_fixed_matrix},
+        {"float16", bench_float16},
+        {"hugepage", bench_hugepage},
+        {"interleaved", bench_interleaved},
+        {"micro_batch", bench_micro_batch},
+        {"one_hot", bench_one_hot},
+        {"padding", bench_padding},
+        {"quantize", bench_quantize},
+        {"ragged", bench_ragged},
+        {"refcount", bench_refcount},
+        {"sparse", bench_sparse},
+        {"tiled", bench_tiled},
+    };
+    if (argc < 2)
+    {
+        for (auto& [name, bench] : benchmarks)
+        {
+            bench();
+        }
+        return 0;
+    }
+    for (int i = 1; i < argc; ++i)
+    {
+        auto it = benchmarks.find(argv[i]);
+        if (it == benchmarks.end())
+        {
+            std::cerr << "Unknown benchmark: " << argv[i] << "\n";
+            return 1;
+        }
+        it->second();
+    }
+    return 0;
+}
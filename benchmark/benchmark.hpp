@@ -0,0 +1,154 @@
+#pragma once
+
+#include <data/matrix/matrix.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 计时工具：返回执行func耗费的秒数
+template<typename TFunc>
+double measureSeconds(TFunc&& func)
+{
+    auto begin = std::chrono::steady_clock::now();
+    std::forward<TFunc>(func)();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - begin).count();
+}
+
+// 防止被测计算被编译器优化掉
+template<typename T>
+void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// 执行iterations次func，返回平均每次的毫秒数
+template<typename TFunc>
+double milliseconds(std::size_t iterations, TFunc&& func)
+{
+    double seconds = measureSeconds([&]() {
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            func();
+        }
+    });
+    return seconds / iterations * 1e3;
+}
+
+// 基准测试的输入矩阵：元素取[-0.5, 0.5)之间确定的值，各次运行的结果可以比较
+template<typename TElem = float>
+MetaNN::Matrix<TElem> makeMatrix(std::size_t row, std::size_t col)
+{
+    MetaNN::Matrix<TElem> res(row, col);
+    auto view = res.mutableView();
+    for (std::size_t i = 0; i < row; ++i)
+    {
+        for (std::size_t j = 0; j < col; ++j)
+        {
+            view(i, j) = static_cast<TElem>(static_cast<float>((i * 7 + j * 3) % 23) / 23.0f - 0.5f);
+        }
+    }
+    return res;
+}
+
+// 输出同一运算两种实现的每次执行毫秒数：name  before ms -> after ms
+inline void printComparison(const char* name, double before, double after)
+{
+    std::cout << std::setw(28) << std::left << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(9) << before << " ms -> " << std::setw(9) << after << " ms\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+// 硬件缓存未命中计数（Linux perf_event），不可用时（比如没有权限、虚拟机中没有性能计数器）valid()为false
+class CacheMissCounter
+{
+public:
+    CacheMissCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+#endif
+    }
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    bool valid() const
+    {
+        return m_fd >= 0;
+    }
+    // 返回执行func期间的缓存未命中次数，不可用时返回0
+    template<typename TFunc>
+    std::uint64_t measure(TFunc&& func)
+    {
+        std::uint64_t count = 0;
+#ifdef __linux__
+        if (valid())
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+            std::forward<TFunc>(func)();
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+            {
+                count = 0;
+            }
+            return count;
+        }
+#endif
+        std::forward<TFunc>(func)();
+        return count;
+    }
+
+private:
+    int m_fd = -1;
+};
+
+inline void printBenchmarkTitle(const std::string& title)
+{
+    std::cout << "\n==================== " << title << " ====================\n";
+}
+
+// 基准测试函数声明
+void bench_allocator();
+void bench_array();
+void bench_broadcast();
+void bench_duplicate();
+void bench_fixed_matrix();
+void bench_float16();
+void bench_hugepage();
+void bench_interleaved();
+void bench_micro_batch();
+void bench_one_hot();
+void bench_padding();
+void bench_quantize();
+void bench_ragged();
+void bench_refcount();
+void bench_sparse();
+void bench_tiled();
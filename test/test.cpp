@@ -8,9 +8,9 @@ int main(int argc, char const *argv[])
     test_data();
     // test_operator();
     // test_policy();
-    // test_param_initializer();
+    test_param_initializer();
     // test_layer();
-    // test_evaluation();
+    test_evaluation();
     util.showFinalResult();
     return 0;
 }
@@ -3,18 +3,111 @@
 #include <data/allocator.hpp>
 #include <data/lower_access.hpp>
 #include <data/scalar.hpp>
+#include <data/float16.hpp>
+#include <data/numeric_policy.hpp>
 #include <data/matrix/matrix.hpp>
+#include <data/matrix/fixed_matrix.hpp>
 #include <data/matrix/trivial_matrix.hpp>
 #include <data/matrix/zero_matrix.hpp>
 #include <data/matrix/one_hot_vector.hpp>
+#include <data/matrix/sparse_matrix.hpp>
+#include <data/matrix/quantized_matrix.hpp>
+#include <data/matrix/tiled_matrix.hpp>
 #include <data/batch/batch.hpp>
 #include <data/batch/array.hpp>
 #include <data/batch/duplicate.hpp>
+#include <data/batch/batch_sparse_matrix.hpp>
+#include <data/batch/batch_one_hot_vector.hpp>
+#include <data/batch/interleaved_batch.hpp>
+#include <data/batch/ragged_batch.hpp>
+#include <data/mapped_file.hpp>
+#include <data/external_memory.hpp>
+#include <facility/data_copy.hpp>
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+
+#include <thread>
+#include <fstream>
+#include <vector>
+#include <numeric>
+#include <utility>
+#include <filesystem>
+#include <cmath>
+#include <limits>
+#include <bit>
 
 #include "test.hpp"
 
 using namespace MetaNN;
 
+// 为long double指定使用内存池分配，并按页对齐
+template<>
+struct MetaNN::DataMemoryPolicy_<long double, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PPoolAllocator, PAlignmentIs<PageSize>>;
+};
+// short仅在单线程中使用，选择非原子引用计数
+template<>
+struct MetaNN::DataMemoryPolicy_<short, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PNonAtomicRefCount>;
+};
+
+// unsigned不小于1MB的内存块使用大页
+template<>
+struct MetaNN::DataMemoryPolicy_<unsigned, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PHugePageAllocator, PHugePageThresholdIs<(std::size_t(1) << 20)>>;
+};
+
+// long跟踪内存分配
+template<>
+struct MetaNN::DataMemoryPolicy_<long, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PTrackAllocation>;
+};
+
+// unsigned short的矩阵每行填充到64字节（32个元素）
+template<>
+struct MetaNN::DataMemoryPolicy_<unsigned short, DeviceTags::CPU>
+{
+    using type = PolicyContainer<PRowAlignmentIs<64>>;
+};
+
+// 编译期形状的矩阵
+static_assert(MatrixC<FixedMatrix<float, 4, 4>>);
+static_assert(FixedMatrixC<FixedMatrix<float, 4, 4>> && !FixedMatrixC<Matrix<float>>);
+static_assert(sizeof(FixedMatrix<float, 4, 4>) == 16 * sizeof(float));
+// 16位浮点与累加类型
+static_assert(std::same_as<AccumulateType<Float16, DeviceTags::CPU>, float>);
+static_assert(std::same_as<AccumulateType<BFloat16, DeviceTags::CPU>, float>);
+static_assert(std::same_as<AccumulateType<double, DeviceTags::CPU>, double>);
+static_assert(std::is_trivially_copyable_v<Float16> && std::is_trivially_copyable_v<BFloat16>);
+
+// 稀疏矩阵
+static_assert(MatrixC<SparseMatrix<float>> && BatchMatrixC<BatchSparseMatrix<float>>);
+
+// 分块矩阵
+static_assert(MatrixC<TiledMatrix<float>> && TiledMatrixC<TiledMatrix<float, DeviceTags::CPU, 4>> && !TiledMatrixC<Matrix<float>>);
+
+// 量化矩阵
+static_assert(MatrixC<QuantizedMatrix<float>> && QuantizedMatrixC<QuantizedMatrix<double, DeviceTags::CPU, QuantizeTags::PerRow>>);
+
+// allocator
+static_assert(std::same_as<AllocatorOf<unsigned, DeviceTags::CPU>,
+                           HugePagePolicyAllocator<DeviceTags::CPU, (std::size_t(1) << 20), false>>);
+static_assert(std::same_as<AllocatorOf<double, DeviceTags::CPU>, Allocator<DeviceTags::CPU>>);
+static_assert(std::same_as<AllocatorOf<long double, DeviceTags::CPU>, PoolAllocator<DeviceTags::CPU>>);
+static_assert(std::same_as<DataMemoryPolicy<double, DeviceTags::CPU>::RefCount, MemoryPolicy::RefCountTypeCategory::Atomic>);
+static_assert(std::same_as<DataMemoryPolicy<short, DeviceTags::CPU>::RefCount, MemoryPolicy::RefCountTypeCategory::NonAtomic>);
+static_assert(paddedRowLen<double, DeviceTags::CPU>(5) == 5);
+static_assert(paddedRowLen<unsigned short, DeviceTags::CPU>(5) == 32 && paddedRowLen<unsigned short, DeviceTags::CPU>(33) == 64);
+static_assert(sizeof(MemoryBlockHeader<RefCounter<MemoryPolicy::RefCountTypeCategory::Atomic>>)
+              < sizeof(MemoryBlockHeader<RefCounter<MemoryPolicy::RefCountTypeCategory::Atomic>, true>));
+static_assert(MemoryAlignment<double, DeviceTags::CPU> == 64);
+static_assert(MemoryAlignment<long double, DeviceTags::CPU> == 4096);
+static_assert(LowerAccessImpl<Matrix<double>>::Alignment == 64);
+static_assert(LowerAccessImpl<CpuBatchMatix<long double>>::Alignment == 4096);
 // scalar
 static_assert(ScalarC<Scalar<double>>);
 static_assert(ScalarC<Scalar<double, DeviceTags::CPU>>);
@@ -46,6 +139,10 @@ static_assert(std::same_as<Matrix<double>, PrincipalDataType<CategoryTags::Matri
 static_assert(std::same_as<Batch<double, DeviceTags::CPU, CategoryTags::Scalar>, PrincipalDataType<CategoryTags::BatchScalar, double, DeviceTags::CPU>>);
 static_assert(std::same_as<Batch<double, DeviceTags::CPU, CategoryTags::Matrix>, PrincipalDataType<CategoryTags::BatchMatrix, double, DeviceTags::CPU>>);
 
+void test_allocator(TestUtil& util);
+void test_mapped_file(TestUtil& util);
+void test_external_memory(TestUtil& util);
+void test_float16(TestUtil& util);
 void test_scalar(TestUtil& util);
 void test_matrix(TestUtil& util);
 void test_batch_scalar(TestUtil& util);
@@ -53,11 +150,21 @@ void test_batch_matrix(TestUtil& util);
 void test_trivial_matrix(TestUtil& util);
 void test_zero_matrix(TestUtil& util);
 void test_one_hot_vector(TestUtil& util);
+void test_batch_one_hot_vector(TestUtil& util);
+void test_interleaved_batch(TestUtil& util);
+void test_ragged_batch(TestUtil& util);
+void test_sparse_matrix(TestUtil& util);
+void test_quantized_matrix(TestUtil& util);
+void test_tiled_matrix(TestUtil& util);
 void test_array(TestUtil& util);
 void test_duplicate(TestUtil& util);
 
 void test_data(TestUtil& util)
 {
+    test_allocator(util);
+    test_mapped_file(util);
+    test_external_memory(util);
+    test_float16(util);
     test_scalar(util);
     test_matrix(util);
     test_batch_scalar(util);
@@ -65,10 +172,433 @@ void test_data(TestUtil& util)
     test_trivial_matrix(util);
     test_zero_matrix(util);
     test_one_hot_vector(util);
+    test_batch_one_hot_vector(util);
+    test_interleaved_batch(util);
+    test_ragged_batch(util);
+    test_sparse_matrix(util);
+    test_quantized_matrix(util);
+    test_tiled_matrix(util);
     test_array(util);
     test_duplicate(util);
 }
 
+void test_allocator(TestUtil& util)
+{
+    util.setTestGroup("data.allocator");
+    using Pool = PoolAllocator<DeviceTags::CPU>;
+    // 大小类别
+    {
+        util.assertEqual(Pool::sizeClass(1), 64);
+        util.assertEqual(Pool::sizeClass(64), 64);
+        util.assertEqual(Pool::sizeClass(65), 80);
+        util.assertEqual(Pool::sizeClass(513), 640);
+        util.assertEqual(Pool::sizeClass(1024), 1024);
+    }
+    // 释放的内存块回到池中，再次分配相同大小类别时复用
+    {
+        Pool::trim();
+        Pool::resetStatistics();
+        long double* first = nullptr;
+        {
+            Matrix<long double> mat(10, 10);
+            first = lowerAccess(mat).rawMemory();
+        }
+        util.assertEqual(Pool::statistics().cachedBlocks, 1);
+        Matrix<long double> mat(10, 10);
+        util.assertEqual(lowerAccess(mat).rawMemory(), first);
+        auto stats = Pool::statistics();
+        util.assertEqual(stats.allocateCount, 2);
+        util.assertEqual(stats.hitCount, 1);
+        util.assertEqual(stats.missCount, 1);
+        util.assertEqual(stats.hitRate(), 0.5);
+        util.assertEqual(stats.cachedBlocks, 0);
+        util.assertEqual(lowerAccess(mat).isAligned(), true);
+        util.assertEqual(reinterpret_cast<std::uintptr_t>(lowerAccess(mat).rawMemory()) % PageSize, 0);
+    }
+    // trim
+    {
+        Pool::trim();
+        Pool::allocate(100 * sizeof(double), 64).release();
+        util.assertEqual(Pool::statistics().cachedBytes, Pool::sizeClass(100 * sizeof(double)));
+        Pool::trim();
+        util.assertEqual(Pool::statistics().cachedBlocks, 0);
+        util.assertEqual(Pool::statistics().cachedBytes, 0);
+    }
+    // 引用计数：控制块与数据在同一次分配中
+    {
+        Pool::resetStatistics();
+        ContinuousMemory<long double, DeviceTags::CPU> mem(10);
+        util.assertEqual(Pool::statistics().allocateCount, 1);
+        util.assertEqual(mem.useCount(), 1);
+        {
+            auto copy = mem;
+            ContinuousMemory<long double, DeviceTags::CPU> view(mem, mem.rawMemory() + 2);
+            util.assertEqual(mem.useCount(), 3);
+            util.assertEqual(view.useCount(), 3);
+            util.assertEqual(copy == mem, true);
+            util.assertEqual(view == mem, false);
+            auto moved = std::move(copy);
+            util.assertEqual(mem.useCount(), 3);
+        }
+        util.assertEqual(mem.useCount(), 1);
+        Matrix<short> mat(3, 3);
+        auto sub = mat.subMatrix(0, 2, 0, 2);
+        util.assertEqual(mat.availableForWrite(), false);
+        sub = Matrix<short>();
+        util.assertEqual(mat.availableForWrite(), true);
+        // 接管智能指针维护的内存
+        std::shared_ptr<double> sp(new double[4]{1, 2, 3, 4}, [](double* p) { delete [] p; });
+        {
+            ContinuousMemory<double, DeviceTags::CPU> adopted(sp, sp.get() + 1);
+            util.assertEqual(*adopted.rawMemory(), 2.0);
+            util.assertEqual(sp.use_count(), 2);
+        }
+        util.assertEqual(sp.use_count(), 1);
+    }
+    // 线程缓存
+    {
+        using Cached = ThreadCacheAllocator<DeviceTags::CPU>;
+        auto before = Cached::statistics();
+        RawMemory raw1 = Cached::allocate(800, 64);
+        void* first = raw1.ptr;
+        raw1.release();
+        RawMemory raw2 = Cached::allocate(800, 64);
+        util.assertEqual(raw2.ptr, first);
+        // 在其他线程释放，送回本线程的缓存
+        std::thread([raw2]() { raw2.release(); }).join();
+        RawMemory raw3 = Cached::allocate(800, 64);
+        util.assertEqual(raw3.ptr, first);
+        raw3.release();
+        auto after = Cached::statistics();
+        util.assertEqual(after.allocateCount - before.allocateCount, 3);
+        util.assertEqual(after.localHitCount - before.localHitCount, 2);
+        util.assertEqual(after.remoteFreeCount - before.remoteFreeCount, 1);
+        // 其他线程创建自己的缓存，线程退出后缓存被复用
+        std::thread([]() { Cached::allocate(80, 8).release(); }).join();
+        std::thread([]() { Cached::allocate(80, 8).release(); }).join();
+        util.assertEqual(Cached::statistics().threadCacheCount, 2);
+    }
+    // 竞技场
+    {
+        ArenaAllocator<DeviceTags::CPU> arena(4096);
+        Matrix<double> param(4, 4);
+        const double* first = nullptr;
+        {
+            ArenaScope scope(arena);
+            Matrix<double> mat1(10, 10);
+            Matrix<double> mat2(10, 10);
+            first = lowerAccess(mat1).rawMemory();
+            util.assertEqual(arena.liveBlocks(), 2);
+            util.assertEqual(arena.chunkCount(), 1);
+            util.assertEqual(lowerAccess(mat2).isAligned(), true);
+            {
+                PersistentMemoryScope<DeviceTags::CPU> persistent;
+                param = Matrix<double>(4, 4);
+                util.assertEqual(arena.liveBlocks(), 2);
+            }
+            Matrix<double> mat3(20, 20);
+            util.assertEqual(arena.chunkCount(), 2);
+        }
+        util.assertEqual(ArenaAllocator<DeviceTags::CPU>::active() == nullptr, true);
+        util.assertEqual(arena.liveBlocks(), 0);
+        arena.reset();
+        util.assertEqual(arena.chunkCount(), 1);
+        util.assertEqual(arena.usedBytes(), 0);
+        {
+            ArenaScope scope(arena);
+            first = lowerAccess(Matrix<double>(10, 10)).rawMemory();
+        }
+        arena.reset();
+        {
+            ArenaScope scope(arena);
+            Matrix<double> mat1(10, 10);
+            Matrix<double> mat2(20, 20);
+            util.assertEqual(arena.chunkCount(), 1);
+            util.assertEqual(lowerAccess(mat1).rawMemory(), first);
+            bool thrown = false;
+            try
+            {
+                arena.reset();
+            }
+            catch (const std::runtime_error&)
+            {
+                thrown = true;
+            }
+            util.assertEqual(thrown, true);
+        }
+        arena.reset();
+        param.setValue(0, 0, 1.0);
+        util.assertEqual(param(0, 0), 1.0);
+
+        // 竞技场作用域中接管的外部内存不占用竞技场内存块，可以比作用域活得更久
+        std::shared_ptr<double> sp(new double[4]{1, 2, 3, 4}, [](double* p) { delete [] p; });
+        ContinuousMemory<double, DeviceTags::CPU> adopted(sp, sp.get());
+        {
+            ArenaScope scope(arena);
+            adopted = ContinuousMemory<double, DeviceTags::CPU>(sp, sp.get() + 1);
+            util.assertEqual(arena.liveBlocks(), 0);
+        }
+        arena.reset();
+        util.assertEqual(adopted.rawMemory()[0], 2.0);
+    }
+    // 大页分配器：超过阈值的内存块按大页对齐映射，统计大页提供的字节数
+    {
+        using HugePages = HugePageAllocator<DeviceTags::CPU>;
+        HugePages::resetStatistics();
+        std::size_t live = HugePages::statistics().liveHugePageBytes;
+        {
+            ContinuousMemory<unsigned, DeviceTags::CPU> small(1000);
+            ContinuousMemory<unsigned, DeviceTags::CPU> large(1 << 20);
+            util.assertEqual(reinterpret_cast<std::uintptr_t>(large.rawMemory()) % HugePages::HugePageSize, 0);
+            large.rawMemory()[(1 << 20) - 1] = 1;
+            util.assertEqual(large.rawMemory()[(1 << 20) - 1], 1);
+            auto stats = HugePages::statistics();
+            util.assertEqual(stats.allocateCount, 2);
+            // 数据与控制块共4MB多，映射3个大页
+            util.assertEqual(stats.hugePageBytes() + stats.fallbackBytes, 3 * HugePages::HugePageSize);
+            util.assertEqual(stats.liveHugePageBytes - live, stats.hugePageBytes());
+        }
+        util.assertEqual(HugePages::statistics().liveHugePageBytes, live);
+        RawMemory raw = HugePages::allocate(HugePages::HugePageSize, 64, HugePages::HugePageSize, true);
+        util.assertEqual(raw.size, HugePages::HugePageSize);
+        raw.release();
+        util.assertEqual(HugePages::statistics().allocateCount, 3);
+    }
+    // 内存分配跟踪
+    {
+        MemoryTracker::reset();
+        std::size_t live = MemoryTracker::snapshot().liveBytes;
+        {
+            Matrix<long> mat(10, 10);
+            Matrix<double> untracked(10, 10);
+            auto stats = MemoryTracker::snapshot();
+            util.assertEqual(stats.allocateCount, 1);
+            util.assertEqual(stats.liveBytes - live, 100 * sizeof(long));
+            util.assertEqual(stats.histogram[MemoryTrackerStatistics::bucketOf(100 * sizeof(long))], 1);
+            util.assertEqual(stats.tags["Matrix"].liveBytes, 100 * sizeof(long));
+            {
+                AllocationTagScope scope("OpDot");
+                Batch<long, DeviceTags::CPU, CategoryTags::Matrix> batch(2, 10, 10);
+                Matrix<long> mat2(mat);
+                mat2.setValue(0, 0, 1);
+                stats = MemoryTracker::snapshot();
+                util.assertEqual(stats.allocateCount, 3);
+                util.assertEqual(stats.tags["OpDot"].allocateCount, 2);
+                util.assertEqual(stats.tags["OpDot"].liveBytes, 300 * sizeof(long));
+            }
+            stats = MemoryTracker::snapshot();
+            util.assertEqual(stats.freeCount, 2);
+            util.assertEqual(stats.tags["OpDot"].liveBytes, 0);
+            util.assertEqual(stats.peakBytes - live, 400 * sizeof(long));
+        }
+        util.assertEqual(MemoryTracker::snapshot().liveBytes, live);
+        MemoryTracker::reset();
+        auto stats = MemoryTracker::snapshot();
+        util.assertEqual(stats.allocateCount, 0);
+        util.assertEqual(stats.peakBytes, live);
+        util.assertEqual(stats.tags.count("OpDot"), 0);
+    }
+    util.showGroupResult();
+}
+
+void test_mapped_file(TestUtil& util)
+{
+    util.setTestGroup("data.mapped_file");
+    auto path = std::filesystem::temp_directory_path() / "metann_test_mapped_file.bin";
+    {
+        std::vector<float> values(2 + 2 * 3 * 4);
+        std::iota(values.begin(), values.end(), 0.0f);
+        std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+        ofs.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+    }
+    // 只读映射：零拷贝读取，写入时脱离映射
+    {
+        MappedFile file(path.string());
+        util.assertEqual(file.size(), 26 * sizeof(float));
+        auto header = mapBatchScalar<float>(file, 0, 2);
+        util.assertEqual(header[1], 1);
+        auto batch = mapBatchMatrix<float>(file, 2 * sizeof(float), 2, 3, 4);
+        util.assertEqual(batch[1](2, 3), 25);
+        util.assertEqual(lowerAccess(batch).rawMemory(), static_cast<const float*>(file.data()) + 2);
+        util.assertEqual(batch.availableForWrite(), false);
+
+        auto mat = mapMatrix<float>(file, 2 * sizeof(float), 3, 4);
+        util.assertEqual(mat(1, 2), 8);
+        util.assertEqual(mat.availableForWrite(), false);
+        mat.setValue(1, 2, -1);
+        util.assertEqual(mat(1, 2), -1);
+        util.assertEqual(mat(2, 3), 13);
+        util.assertEqual(mat.availableForWrite(), true);
+        util.assertEqual(batch[0](1, 2), 8);
+
+        bool thrown = false;
+        try
+        {
+            mapMatrix<float>(file, 0, 5, 6);
+        }
+        catch (const std::out_of_range&)
+        {
+            thrown = true;
+        }
+        util.assertEqual(thrown, true);
+    }
+    // 私有映射：数据独占时可以直接写入，写入不影响文件
+    {
+        Matrix<float> mat;
+        {
+            MappedFile file(path.string(), MapMode::Private);
+            mat = mapMatrix<float>(file, 2 * sizeof(float), 3, 4);
+        }
+        util.assertEqual(mat.availableForWrite(), true);
+        auto p = lowerAccess(mat).rawMemory();
+        mat.setValue(0, 0, 100);
+        util.assertEqual(lowerAccess(mat).rawMemory(), p);
+        util.assertEqual(mat(0, 0), 100);
+
+        MappedFile file(path.string());
+        util.assertEqual(mapMatrix<float>(file, 2 * sizeof(float), 3, 4)(0, 0), 2);
+    }
+    // 私有映射上同一区域的两个数据互不影响：映射被共享时写入先脱离映射
+    {
+        MappedFile file(path.string(), MapMode::Private);
+        auto m1 = mapMatrix<float>(file, 0, 2, 2);
+        auto m2 = mapMatrix<float>(file, 0, 2, 2);
+        util.assertEqual(m1.availableForWrite(), false);
+        m1.setValue(0, 0, 42);
+        util.assertEqual(m1(0, 0), 42);
+        util.assertEqual(m2(0, 0), 0);
+        util.assertEqual(lowerAccess(m2).rawMemory(), static_cast<const float*>(file.data()));
+        util.assertEqual(lowerAccess(m1).rawMemory() != lowerAccess(m2).rawMemory(), true);
+
+        // 映射对象销毁后，仍有两个数据共享映射，都不能直接写入
+        Matrix<float> m3, m4;
+        {
+            MappedFile tmp(path.string(), MapMode::Private);
+            m3 = mapMatrix<float>(tmp, 0, 2, 2);
+            m4 = mapMatrix<float>(tmp, 0, 2, 2);
+        }
+        util.assertEqual(m3.availableForWrite(), false);
+        m3.setValue(0, 1, -5);
+        util.assertEqual(m4(0, 1), 1);
+        util.assertEqual(m4.availableForWrite(), true);
+    }
+    std::filesystem::remove(path);
+    util.showGroupResult();
+}
+
+void test_external_memory(TestUtil& util)
+{
+    util.setTestGroup("data.external_memory");
+    // deleter：最后一个引用释放时调用
+    {
+        int deleted = 0;
+        float* buffer = new float[2 * 4];
+        std::iota(buffer, buffer + 8, 0.0f);
+        {
+            auto mat = externalMatrix(buffer, 2, 3, 4, [&deleted](float* p) { delete[] p; ++deleted; });
+            util.assertEqual(mat(1, 2), 6);
+            util.assertEqual(lowerAccess(mat).rawMemory(), buffer);
+            util.assertEqual(lowerAccess(mat).rowLen(), 4);
+            util.assertEqual(mat.availableForWrite(), true);
+            mat.setValue(0, 0, -1);
+            util.assertEqual(buffer[0], -1);
+            auto sub = mat.subMatrix(1, 2, 1, 3);
+            mat = Matrix<float>();
+            util.assertEqual(deleted, 0);
+            util.assertEqual(sub(0, 1), 6);
+        }
+        util.assertEqual(deleted, 1);
+    }
+    // keepAlive：与调用方共享所有权
+    {
+        auto owner = std::make_shared<std::vector<double>>(3 * 2 * 2);
+        std::iota(owner->begin(), owner->end(), 0.0);
+        auto batch = externalBatchMatrix(owner->data(), 2, 2, 2, 3, 6, owner);
+        util.assertEqual(batch[1](1, 1), 10);
+        util.assertEqual(batch[0](1, 0), 3);
+        auto scalars = externalBatchScalar(owner->data() + 6, 6, owner);
+        util.assertEqual(scalars[5], 11);
+        util.assertEqual(owner.use_count(), 3);
+    }
+    // const外部内存为只读，写入时复制
+    {
+        const double data[] = {1, 2, 3, 4};
+        auto mat = externalMatrix(data, 2, 2, 2, std::shared_ptr<void>());
+        util.assertEqual(mat.availableForWrite(), false);
+        mat.setValue(1, 1, 0);
+        util.assertEqual(mat(1, 1), 0);
+        util.assertEqual(data[3], 4);
+    }
+    util.showGroupResult();
+}
+
+void test_float16(TestUtil& util)
+{
+    util.setTestGroup("data.float16");
+    // Float16的转换与舍入
+    {
+        util.assertEqual(float(Float16(1.0f)), 1.0f);
+        util.assertEqual(Float16(1.0f).bits(), 0x3C00);
+        util.assertEqual(Float16(-2.5f).bits(), 0xC100);
+        util.assertEqual(float(Float16(65504.0f)), 65504.0f);
+        util.assertEqual(Float16(65520.0f).bits(), 0x7C00);
+        util.assertEqual(Float16(1e-7f).bits(), 0x0002);
+        util.assertEqual(float(Float16::fromBits(0x0001)), std::ldexp(1.0f, -24));
+        // 就近舍入到偶数：1 + 2^-11恰好在1与1 + 2^-10的中点
+        util.assertEqual(Float16(1.0f + std::ldexp(1.0f, -11)).bits(), 0x3C00);
+        util.assertEqual(Float16(1.0f + 3 * std::ldexp(1.0f, -11)).bits(), 0x3C02);
+        util.assertEqual(std::isinf(float(Float16(std::numeric_limits<float>::infinity()))), true);
+        util.assertEqual(std::isnan(float(Float16(std::numeric_limits<float>::quiet_NaN()))), true);
+        // 16位所有取值都能经float无损往返
+        bool roundTrip = true;
+        for (std::uint32_t bits = 0; bits < 0x10000; ++bits)
+        {
+            Float16 val = Float16::fromBits(static_cast<std::uint16_t>(bits));
+            if (!std::isnan(float(val)) && Float16(float(val)).bits() != bits)
+            {
+                roundTrip = false;
+            }
+        }
+        util.assertEqual(roundTrip, true);
+    }
+    // BFloat16的转换与舍入
+    {
+        util.assertEqual(BFloat16(1.0f).bits(), 0x3F80);
+        util.assertEqual(float(BFloat16(3.0e38f)) > 2.9e38f, true);
+        util.assertEqual(BFloat16(1.0f + std::ldexp(1.0f, -8)).bits(), 0x3F80);
+        util.assertEqual(BFloat16(1.0f + 3 * std::ldexp(1.0f, -8)).bits(), 0x3F82);
+        util.assertEqual(std::isnan(float(BFloat16(std::bit_cast<float>(0x7F800001u)))), true);
+        // 精度只有8位：256 + 1舍入为256
+        util.assertEqual(BFloat16(256.0f) + BFloat16(1.0f), BFloat16(256.0f));
+    }
+    // 运算与比较
+    {
+        Float16 a(1.5f);
+        Float16 b(2.0f);
+        static_assert(std::same_as<decltype(a + b), Float16>);
+        util.assertEqual(a * b, Float16(3.0f));
+        util.assertEqual(-a, Float16(-1.5f));
+        util.assertEqual(a < b, true);
+        util.assertEqual(a + 1.0f, 2.5f);
+        a += b;
+        util.assertEqual(float(a), 3.5f);
+        util.assertEqual(Float16(0.0f) == -Float16(0.0f), true);
+    }
+    // 作为数据的元素类型
+    {
+        Scalar<BFloat16> scalar(BFloat16(2.0f));
+        util.assertEqual(float(scalar.value()), 2.0f);
+        Matrix<Float16> mat(3, 4);
+        mat.setValue(1, 2, Float16(0.25f));
+        util.assertEqual(mat(1, 2), Float16(0.25f));
+        util.assertEqual(lowerAccess(mat).isAligned(), true);
+        Batch<BFloat16, DeviceTags::CPU, CategoryTags::Matrix> batch(2, 3, 4);
+        batch.setValue(1, 2, 3, BFloat16(-8.0f));
+        util.assertEqual(batch[1](2, 3), BFloat16(-8.0f));
+    }
+    util.showGroupResult();
+}
+
 void test_scalar(TestUtil& util)
 {
     util.setTestGroup("data.scalar");
@@ -106,6 +636,180 @@ void test_matrix(TestUtil& util)
         auto acc = lowerAccess(mat);
         util.assertEqual(acc.rowLen(), 3);
         util.assertEqual(*(acc.rawMemory() + 1 * 3 + 1), 10.5);
+        util.assertEqual(acc.isAligned(), true);
+        util.assertEqual(lowerAccess(mat.subMatrix(0, 2, 1, 3)).isAligned(), false);
+    }
+    // 写时复制
+    {
+        CopyOnWrite::resetStatistics();
+        Matrix<double> mat(10, 10);
+        iota(mat);
+        Matrix<double> mat2(mat);
+        auto sub = mat.subMatrix(2, 5, 3, 7);
+        mat2.setValue(0, 0, -1);
+        util.assertEqual(mat2(0, 0), -1);
+        util.assertEqual(mat(0, 0), 0);
+        util.assertEqual(mat2.availableForWrite(), true);
+        util.assertEqual(CopyOnWrite::statistics().matrixDetachCount, 1);
+        util.assertEqual(CopyOnWrite::statistics().detachedBytes, 100 * sizeof(double));
+        mat2.setValue(0, 1, -2);
+        util.assertEqual(CopyOnWrite::statistics().matrixDetachCount, 1);
+        // 子矩阵脱离后只复制可见部分
+        sub.setValue(0, 0, -3);
+        util.assertEqual(sub(0, 0), -3);
+        util.assertEqual(sub(2, 3), 46);
+        util.assertEqual(mat(2, 3), 23);
+        util.assertEqual(lowerAccess(sub).rowLen(), 4);
+        util.assertEqual(mat.availableForWrite(), true);
+        util.assertEqual(CopyOnWrite::statistics().matrixDetachCount, 2);
+    }
+    // 批量访问视图
+    {
+        Matrix<double> mat(4, 5);
+        iota(mat);
+        auto view = mat.view();
+        util.assertEqual(view.isContiguous(), true);
+        util.assertEqual(view.elements().size(), 20);
+        util.assertEqual(view.row(2)[3], 13);
+        double sum = 0;
+        for (auto row : view)
+        {
+            sum += std::accumulate(row.begin(), row.end(), 0.0);
+        }
+        util.assertEqual(sum, 190);
+        auto subView = mat.subMatrix(1, 3, 1, 4).view();
+        util.assertEqual(subView.isContiguous(), false);
+        util.assertEqual(subView.rowStride(), 5);
+        util.assertEqual(subView.row(1)[2], mat(2, 3));
+        util.assertEqual(subView.transpose()(2, 1), mat(2, 3));
+        util.assertEqual(mat.transpose().view().isRowContiguous(), false);
+        util.assertEqual(mat.transpose().view()(3, 2), mat(2, 3));
+        // 可写视图在共享时先脱离共享
+        Matrix<double> mat2(mat);
+        for (auto row : mat2.mutableView())
+        {
+            std::ranges::fill(row, 1.0);
+        }
+        util.assertEqual(mat2(3, 4), 1);
+        util.assertEqual(mat(3, 4), 19);
+    }
+    // 转置视图
+    {
+        Matrix<double> mat(3, 5);
+        iota(mat);
+        auto trans = mat.transpose();
+        util.assertEqual(trans.rowNum(), 5);
+        util.assertEqual(trans.colNum(), 3);
+        util.assertEqual(trans(4, 1), mat(1, 4));
+        util.assertEqual(lowerAccess(trans).rawMemory(), lowerAccess(mat).rawMemory());
+        util.assertEqual(lowerAccess(trans).rowLen(), 1);
+        util.assertEqual(lowerAccess(trans).colStride(), 5);
+        util.assertEqual(trans.transpose(), mat);
+        auto sub = trans.subMatrix(1, 4, 1, 3);
+        util.assertEqual(sub(2, 1), mat(2, 3));
+        // 写入时脱离共享，复制为紧密排列
+        trans.setValue(0, 0, -1);
+        util.assertEqual(trans(0, 0), -1);
+        util.assertEqual(trans(4, 2), 14);
+        util.assertEqual(lowerAccess(trans).rowLen(), 3);
+        util.assertEqual(lowerAccess(trans).colStride(), 1);
+        util.assertEqual(mat(0, 0), 0);
+    }
+    // 列向量与行向量的转置
+    {
+        Matrix<double> col(5, 1);
+        iota(col);
+        auto row = col.transpose();
+        util.assertEqual(row.rowNum(), 1);
+        util.assertEqual(row.colNum(), 5);
+        util.assertEqual(row(0, 3), 3);
+        util.assertEqual(row.view().isRowContiguous(), true);
+        util.assertEqual(row.transpose(), col);
+        Matrix<double> vec(1, 4);
+        iota(vec);
+        auto colVec = vec.transpose();
+        util.assertEqual(colVec.rowNum(), 4);
+        util.assertEqual(colVec(2, 0), 2);
+        util.assertEqual(colVec.transpose(), vec);
+        row.setValue(0, 4, -1);
+        util.assertEqual(row(0, 4), -1);
+        util.assertEqual(col(4, 0), 4);
+    }
+    // 编译期形状
+    {
+        FixedMatrix<double, 2, 3> mat;
+        util.assertEqual(mat.rowNum(), 2);
+        util.assertEqual(mat.colNum(), 3);
+        util.assertEqual(mat(1, 2), 0);
+        Matrix<double> ref(2, 3);
+        iota(ref);
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                mat.setValue(i, j, ref(i, j));
+            }
+        }
+        util.assertEqual(mat, ref);
+        util.assertEqual(mat.elements()[4], 4);
+        // 值语义：拷贝后互不影响
+        auto mat2 = mat;
+        mat2.setValue(0, 0, -1);
+        util.assertEqual(mat(0, 0), 0);
+        util.assertEqual(mat.availableForWrite(), true);
+        util.assertEqual(mat.view().isContiguous(), true);
+        util.assertEqual(mat.view().row(1)[2], 5);
+        auto trans = mat.transpose();
+        static_assert(std::same_as<decltype(trans), FixedMatrix<double, 3, 2>>);
+        util.assertEqual(trans, ref.transpose());
+    }
+    // 行填充：每行从64字节对齐的地址开始
+    {
+        using PaddedMatrix = Matrix<unsigned short>;
+        PaddedMatrix mat(3, 5);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 5; ++j)
+            {
+                mat.setValue(i, j, static_cast<unsigned short>(i * 5 + j));
+            }
+        }
+        util.assertEqual(lowerAccess(mat).rowLen(), 32);
+        util.assertEqual(mat.view().rowStride(), 32);
+        util.assertEqual(mat.view().isContiguous(), false);
+        bool rowsAligned = true;
+        for (auto row : mat.view())
+        {
+            rowsAligned = rowsAligned && reinterpret_cast<std::uintptr_t>(row.data()) % 64 == 0;
+        }
+        util.assertEqual(rowsAligned, true);
+        util.assertEqual(mat(2, 4), 14);
+        util.assertEqual(mat.transpose()(4, 2), 14);
+        // 脱离共享后保持填充
+        PaddedMatrix trans = mat.transpose();
+        trans.setValue(0, 0, 100);
+        util.assertEqual(lowerAccess(trans).rowLen(), 32);
+        util.assertEqual(trans(4, 2), 14);
+        util.assertEqual(mat(0, 0), 0);
+        // 运算结果同样填充，且与紧密排列的操作数混合时结果正确
+        auto sum = evaluate(mat + trans.transpose());
+        util.assertEqual(lowerAccess(sum).rowLen(), 32);
+        util.assertEqual(sum(0, 0), 100);
+        util.assertEqual(sum(2, 4), 28);
+        // 与紧密排列的矩阵之间复制
+        ContinuousMemory<unsigned short, DeviceTags::CPU> mem(15, "Matrix");
+        PaddedMatrix dense(std::move(mem), 3, 5, 5);
+        dataCopy(mat, dense);
+        util.assertEqual(dense, mat);
+        util.assertEqual(lowerAccess(dense).rowLen(), 5);
+        util.assertEqual(lowerAccess(dense).rawMemory()[14], 14);
+        // 矩阵列表：每个矩阵也从对齐的地址开始
+        Batch<unsigned short, DeviceTags::CPU, CategoryTags::Matrix> batch(3, 2, 40);
+        util.assertEqual(lowerAccess(batch).rowLen(), 64);
+        util.assertEqual(lowerAccess(batch).rawMatrixSize(), 128);
+        batch.setValue(2, 1, 39, 7);
+        util.assertEqual(batch[2](1, 39), 7);
+        util.assertEqual(reinterpret_cast<std::uintptr_t>(batch.view()[2].row(1).data()) % 64, 0);
     }
     // subMatrix
     {
@@ -146,7 +850,55 @@ void test_batch_scalar(TestUtil& util)
             util.assertEqual(*(acc.rawMemory() + 3), 10);
         }
     }
-    
+    // 写时复制
+    {
+        CopyOnWrite::resetStatistics();
+        CpuBatchScalar<double> s1(5);
+        s1.setValue(0, 1);
+        auto s2 = s1;
+        s2.setValue(0, 2);
+        util.assertEqual(s1[0], 1);
+        util.assertEqual(s2[0], 2);
+        util.assertEqual(CopyOnWrite::statistics().batchScalarDetachCount, 1);
+    }
+    // 批量访问视图
+    {
+        CpuBatchScalar<double> s1(5);
+        s1.setValue(4, 0);
+        auto s2 = s1;
+        auto span = s2.mutableView();
+        std::iota(span.begin(), span.end(), 1.0);
+        util.assertEqual(s2[4], 5);
+        util.assertEqual(s1[4], 0);
+        util.assertEqual(std::accumulate(s2.view().begin(), s2.view().end(), 0.0), 15);
+    }
+    // 按批次切分：共享存储，写入时脱离共享
+    {
+        CopyOnWrite::resetStatistics();
+        CpuBatchScalar<double> s(7);
+        auto span = s.mutableView();
+        std::iota(span.begin(), span.end(), 0.0);
+        auto sub = s.subBatch(2, 5);
+        util.assertEqual(sub.batchNum(), 3);
+        util.assertEqual(sub[0], 2);
+        util.assertEqual(lowerAccess(sub).rawMemory(), lowerAccess(s).rawMemory() + 2);
+        util.assertEqual(s.subBatch(7, 7).batchNum(), 0);
+        sub.setValue(0, -1);
+        util.assertEqual(sub[0], -1);
+        util.assertEqual(s[2], 2);
+        util.assertEqual(CopyOnWrite::statistics().batchScalarDetachCount, 1);
+
+        auto parts = splitBatch(s, 3);
+        util.assertEqual(parts.size(), 3);
+        util.assertEqual(parts[0].batchNum(), 3);
+        util.assertEqual(parts[1].batchNum(), 2);
+        util.assertEqual(parts[2].batchNum(), 2);
+        util.assertEqual(parts[1][0], 3);
+        util.assertEqual(parts[2][1], 6);
+        auto small = splitBatch(s.subBatch(0, 2), 4);
+        util.assertEqual(small[1].batchNum(), 1);
+        util.assertEqual(small[3].batchNum(), 0);
+    }
     util.showGroupResult();
 }
 
@@ -183,6 +935,97 @@ void test_batch_matrix(TestUtil& util)
         util.assertEqual(*acc.rawMemory(), -1);
         util.assertEqual(acc.rowLen(), 3);
         util.assertEqual(acc.rawMatrixSize(), 6);
+        util.assertEqual(lowerAccess(batch2).isAligned(), true);
+    }
+    // 写时复制
+    {
+        CopyOnWrite::resetStatistics();
+        CpuBatchMatix<double> batch(3, 4, 5);
+        iota(batch);
+        auto sub = batch.subBatchMatrix(1, 3, 2, 4);
+        sub.setValue(2, 0, 0, -1);
+        util.assertEqual(sub[2](0, 0), -1);
+        util.assertEqual(sub[2](1, 1), 53);
+        util.assertEqual(batch[2](1, 2), 47);
+        util.assertEqual(lowerAccess(sub).rawMatrixSize(), 4);
+        util.assertEqual(batch.availableForWrite(), true);
+        util.assertEqual(CopyOnWrite::statistics().batchMatrixDetachCount, 1);
+        util.assertEqual(CopyOnWrite::statistics().detachCount(), 1);
+    }
+    // 批量访问视图
+    {
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch(3, 2, 4);
+        iota(batch);
+        auto view = batch.subBatchMatrix(0, 2, 1, 3).view();
+        util.assertEqual(view.batchStride(), 8);
+        util.assertEqual(view(2, 1, 1), batch[2](1, 2));
+        util.assertEqual(view[1].row(0)[1], batch[1](0, 2));
+        auto batch2 = batch;
+        batch2.mutableView()(0, 0, 0) = -1;
+        util.assertEqual(batch2[0](0, 0), -1);
+        util.assertEqual(batch[0](0, 0), 0);
+    }
+    // 转置视图
+    {
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch(2, 3, 4);
+        iota(batch);
+        auto trans = batch.transpose();
+        util.assertEqual(trans.rowNum(), 4);
+        util.assertEqual(trans.colNum(), 3);
+        util.assertEqual(trans[1](3, 2), batch[1](2, 3));
+        util.assertEqual(lowerAccess(trans).rowLen(), 1);
+        util.assertEqual(lowerAccess(trans).colStride(), 4);
+        auto sub = trans.subBatchMatrix(1, 3, 1, 3);
+        util.assertEqual(sub[0](1, 1), batch[0](2, 2));
+        trans.setValue(1, 0, 1, -1);
+        util.assertEqual(trans[1](0, 1), -1);
+        util.assertEqual(trans[1](3, 2), 23);
+        util.assertEqual(lowerAccess(trans).colStride(), 1);
+        util.assertEqual(batch[1](1, 0), 16);
+    }
+    // 列向量与行向量组成的列表的转置
+    {
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> cols(3, 4, 1);
+        iota(cols);
+        auto rows = cols.transpose();
+        util.assertEqual(rows.rowNum(), 1);
+        util.assertEqual(rows.colNum(), 4);
+        util.assertEqual(rows[2](0, 1), cols[2](1, 0));
+        util.assertEqual(rows.transpose()[1], cols[1]);
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> vecs(3, 1, 4);
+        iota(vecs);
+        auto colVecs = vecs.transpose();
+        util.assertEqual(colVecs.rowNum(), 4);
+        util.assertEqual(colVecs[1](3, 0), vecs[1](0, 3));
+        util.assertEqual(colVecs.transpose()[2], vecs[2]);
+    }
+    // 按批次切分：共享存储，保持行间隔与矩阵间隔
+    {
+        CopyOnWrite::resetStatistics();
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch(5, 2, 3);
+        iota(batch);
+        auto sub = batch.subBatch(1, 4);
+        util.assertEqual(sub.batchNum(), 3);
+        util.assertEqual(sub.rowNum(), 2);
+        util.assertEqual(sub[0], batch[1]);
+        util.assertEqual(sub[2], batch[3]);
+        util.assertEqual(lowerAccess(sub).rawMemory(), lowerAccess(batch).rawMemory() + 6);
+        util.assertEqual(CopyOnWrite::statistics().detachCount(), 0);
+        // 转置视图与子矩阵列表的切分
+        auto trans = batch.transpose().subBatch(3, 5);
+        util.assertEqual(trans[1](2, 1), batch[4](1, 2));
+        auto part = batch.subBatchMatrix(0, 2, 1, 3).subBatch(2, 3);
+        util.assertEqual(part[0](1, 1), batch[2](1, 2));
+        sub.setValue(0, 0, 0, -1);
+        util.assertEqual(sub[0](0, 0), -1);
+        util.assertEqual(batch[1](0, 0), 6);
+        util.assertEqual(CopyOnWrite::statistics().batchMatrixDetachCount, 1);
+
+        auto parts = splitBatch(batch, 2);
+        util.assertEqual(parts.size(), 2);
+        util.assertEqual(parts[0].batchNum(), 3);
+        util.assertEqual(parts[1].batchNum(), 2);
+        util.assertEqual(parts[1][1], batch[4]);
     }
     util.showGroupResult();
 }
@@ -210,6 +1053,21 @@ void test_trivial_matrix(TestUtil& util)
         util.assertEqual(mat.colNum(), 10);
         util.assertEqual(mat.elementValue().value(), 3.3);
     }
+    // 广播视图与稠密形式
+    {
+        TrivialMatrix<float> mat(3, 5, 2.5f);
+        auto view = mat.view();
+        util.assertEqual(view.rowNum(), 3);
+        util.assertEqual(view.colNum(), 5);
+        util.assertEqual(view(2, 4), 2.5f);
+        util.assertEqual(view.row(1)[3], 2.5f);
+        util.assertEqual(mat.materialized(), false);
+        auto dense = mat.materialize();
+        util.assertEqual(mat.materialized(), true);
+        util.assertEqual(dense(2, 4), 2.5f);
+        auto copy = mat;
+        util.assertEqual(lowerAccess(copy.materialize()).rawMemory(), lowerAccess(dense).rawMemory());
+    }
     util.showGroupResult();
 }
 
@@ -221,6 +1079,13 @@ void test_zero_matrix(TestUtil& util)
         util.assertEqual(mat.rowNum(), 10);
         util.assertEqual(mat.colNum(), 10);
     }
+    {
+        ZeroMatrix<double> mat(4, 6);
+        util.assertEqual(mat.view()(3, 5), 0.0);
+        auto dense = mat.materialize();
+        util.assertEqual(dense(3, 5), 0.0);
+        util.assertEqual(lowerAccess(mat.materialize()).rawMemory(), lowerAccess(dense).rawMemory());
+    }
     util.showGroupResult();
 }
 
@@ -233,6 +1098,306 @@ void test_one_hot_vector(TestUtil& util)
         util.assertEqual(mat.colNum(), 10);
         util.assertEqual(mat.hotPos(), 3);
     }
+    {
+        OneHotVector<double> mat(5, 2);
+        util.assertEqual(mat(0, 2), 1.0);
+        util.assertEqual(mat(0, 3), 0.0);
+        auto dense = mat.materialize();
+        util.assertEqual(dense.rowNum(), 1);
+        util.assertEqual(dense(0, 1), 0.0);
+        util.assertEqual(dense(0, 2), 1.0);
+        util.assertEqual(mat.materialized(), true);
+    }
+    util.showGroupResult();
+}
+
+void test_batch_one_hot_vector(TestUtil& util)
+{
+    util.setTestGroup("data.batch_one_hot_vector");
+    {
+        std::vector<std::size_t> positions{3, 0, 9, 3};
+        BatchOneHotVector<float> batch(10, positions);
+        static_assert(BatchMatrixC<decltype(batch)>);
+        util.assertEqual(batch.batchNum(), 4);
+        util.assertEqual(batch.rowNum(), 1);
+        util.assertEqual(batch.colNum(), 10);
+        util.assertEqual(batch.hotPos(2), 9);
+        util.assertEqual(batch.hotPositions().size(), 4);
+        util.assertEqual(batch[3].hotPos(), 3);
+        // 复制构造时不依赖原有的位置数组
+        positions[0] = 5;
+        util.assertEqual(batch.hotPos(0), 3);
+        // 共享存储
+        auto copy = batch;
+        util.assertEqual(copy.hotPositions().data(), batch.hotPositions().data());
+
+        util.assertEqual(batch.materialized(), false);
+        auto dense = batch.materialize();
+        util.assertEqual(copy.materialized(), true);
+        util.assertEqual(dense.batchNum(), 4);
+        util.assertEqual(dense[2](0, 9), 1.0f);
+        util.assertEqual(dense[2](0, 3), 0.0f);
+        util.assertEqual(dense[3](0, 3), 1.0f);
+    }
+    util.showGroupResult();
+}
+
+void test_interleaved_batch(TestUtil& util)
+{
+    util.setTestGroup("data.interleaved_batch");
+    {
+        Batch<float, DeviceTags::CPU, CategoryTags::Matrix> batch(5, 2, 3);
+        iota(batch);
+        auto interleaved = makeInterleaved(batch);
+        static_assert(BatchMatrixC<decltype(interleaved)>);
+        util.assertEqual(interleaved.batchNum(), 5);
+        util.assertEqual(interleaved.rowNum(), 2);
+        util.assertEqual(interleaved.colNum(), 3);
+        util.assertEqual(interleaved.laneLen() >= 5, true);
+        // 同一位置的元素连续存放
+        auto lanes = interleaved.lanes(1, 2);
+        util.assertEqual(lanes.size(), 5);
+        for (std::size_t b = 0; b < 5; ++b)
+        {
+            util.assertEqual(lanes[b], batch[b](1, 2));
+            util.assertEqual(interleaved[b], batch[b]);
+        }
+        const auto view = interleaved.view();
+        util.assertEqual(view.batchStride(), 1);
+        util.assertEqual(view(3, 1, 0), batch[3](1, 0));
+        util.assertEqual(makeDense(interleaved)[4], batch[4]);
+
+        // 写时复制
+        auto copy = interleaved;
+        copy.setValue(2, 0, 1, -1.0f);
+        util.assertEqual(copy[2](0, 1), -1.0f);
+        util.assertEqual(interleaved[2](0, 1), batch[2](0, 1));
+        copy.mutableLanes(0, 0)[4] = 7.0f;
+        util.assertEqual(copy[4](0, 0), 7.0f);
+        util.assertEqual(interleaved[4](0, 0), batch[4](0, 0));
+    }
+    util.showGroupResult();
+}
+
+void test_ragged_batch(TestUtil& util)
+{
+    util.setTestGroup("data.ragged_batch");
+    {
+        Batch<float, DeviceTags::CPU, CategoryTags::Matrix> padded(3, 4, 2);
+        iota(padded);
+        const std::vector<std::size_t> rowNums{3, 1, 4};
+        auto ragged = makeRagged(padded, rowNums);
+        static_assert(BatchMatrixC<decltype(ragged)>);
+        util.assertEqual(ragged.batchNum(), 3);
+        util.assertEqual(ragged.colNum(), 2);
+        util.assertEqual(ragged.rowNum(), 4);
+        util.assertEqual(ragged.rowNum(1), 1);
+        util.assertEqual(ragged.rowOffset(2), 4);
+        util.assertEqual(ragged.totalRowNum(), 8);
+        util.assertEqual(ragged[0].rowNum(), 3);
+        util.assertEqual(ragged[0](2, 1), padded[0](2, 1));
+        util.assertEqual(ragged[2], padded[2]);
+        // 各段的行依次紧接存放
+        util.assertEqual(ragged.packedView()(3, 0), padded[1](0, 0));
+        util.assertEqual(ragged.packedView()(4, 1), padded[2](0, 1));
+
+        // 填充回矩阵列表，多出的行为0
+        auto back = makePadded(ragged);
+        util.assertEqual(back.rowNum(), 4);
+        util.assertEqual(back[0](2, 1), padded[0](2, 1));
+        util.assertEqual(back[0](3, 0), 0.0f);
+        util.assertEqual(back[1](3, 1), 0.0f);
+        util.assertEqual(back[2], padded[2]);
+
+        // 写时复制，分段共享
+        auto copy = ragged;
+        copy.setValue(1, 0, 1, -1.0f);
+        util.assertEqual(copy[1](0, 1), -1.0f);
+        util.assertEqual(ragged[1](0, 1), padded[1](0, 1));
+        util.assertEqual(copy.sameSegments(ragged), true);
+        const std::vector<std::size_t> otherRowNums{3, 2, 3};
+        util.assertEqual(RaggedBatch<float>(otherRowNums, 2).sameSegments(ragged), false);
+
+        RaggedBatch<float> empty;
+        util.assertEqual(empty.batchNum(), 0);
+        util.assertEqual(empty.totalRowNum(), 0);
+    }
+    util.showGroupResult();
+}
+
+void test_sparse_matrix(TestUtil& util)
+{
+    util.setTestGroup("data.sparse_matrix");
+    // 由CSR数组构造
+    {
+        // [[0, 1, 0, 2],
+        //  [0, 0, 0, 0],
+        //  [3, 0, 0, 0]]
+        std::vector<std::size_t> rowOffsets{0, 2, 2, 3};
+        std::vector<std::size_t> colIndices{1, 3, 0};
+        std::vector<double> values{1, 2, 3};
+        auto mat = makeSparseMatrix<double>(3, 4, rowOffsets, colIndices, values);
+        util.assertEqual(mat.rowNum(), 3);
+        util.assertEqual(mat.colNum(), 4);
+        util.assertEqual(mat.nonZeroCount(), 3);
+        util.assertEqual(mat(0, 3), 2);
+        util.assertEqual(mat(0, 2), 0);
+        util.assertEqual(mat(1, 1), 0);
+        util.assertEqual(mat(2, 0), 3);
+        util.assertEqual(mat.view().rowIndices(1).size(), 0);
+        auto dense = makeDense(mat);
+        util.assertEqual(dense, mat);
+        util.assertEqual(dense(0, 1), 1);
+    }
+    // 与稠密矩阵互相转换
+    {
+        Matrix<double> dense(5, 6);
+        iota(dense);
+        dense.setValue(1, 2, 0);
+        dense.setValue(4, 5, 0);
+        auto sparse = makeSparse(dense);
+        util.assertEqual(sparse.nonZeroCount(), 27);
+        util.assertEqual(sparse, dense);
+        util.assertEqual(makeDense(sparse), dense);
+        // 子矩阵与转置视图
+        util.assertEqual(makeSparse(dense.subMatrix(1, 3, 1, 4)), dense.subMatrix(1, 3, 1, 4));
+        util.assertEqual(makeSparse(dense.transpose()), dense.transpose());
+    }
+    // 稀疏矩阵列表
+    {
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> dense(3, 2, 4);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            for (auto row : dense.mutableView()[b])
+            {
+                std::ranges::fill(row, 0.0);
+            }
+            dense.setValue(b, b % 2, b, b + 1.0);
+        }
+        dense.setValue(2, 1, 3, -1);
+        auto sparse = makeSparse(dense);
+        util.assertEqual(sparse.batchNum(), 3);
+        util.assertEqual(sparse.nonZeroCount(), 4);
+        util.assertEqual(sparse[1].nonZeroCount(), 1);
+        util.assertEqual(sparse[2](1, 3), -1);
+        util.assertEqual(sparse[2](0, 2), 3);
+        util.assertEqual(sparse, dense);
+        util.assertEqual(makeDense(sparse), dense);
+    }
+    util.showGroupResult();
+}
+
+void test_quantized_matrix(TestUtil& util)
+{
+    util.setTestGroup("data.quantized_matrix");
+    // 整个矩阵共用一组量化参数
+    {
+        Matrix<float> dense(2, 4);
+        const float values[] = {-1, -0.5, 0, 0.5, 1, 1.5, 2, 0.3};
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            dense.setValue(i / 4, i % 4, values[i]);
+        }
+        auto quantized = makeQuantized(dense);
+        util.assertEqual(quantized.rowNum(), 2);
+        util.assertEqual(quantized.colNum(), 4);
+        util.assertEqual(quantized.scale(1), 3.0f / 255);
+        util.assertEqual(quantized.zeroPoint(0), -43);
+        util.assertEqual(quantized.quantizedView()(0, 2), -43);
+        util.assertEqual(quantized.quantizedView()(1, 2), 127);
+        // 0可以被精确表示，其余元素的误差不超过scale的一半
+        util.assertEqual(quantized(0, 2), 0);
+        bool withinHalfStep = true;
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            withinHalfStep = withinHalfStep && std::abs(quantized(i / 4, i % 4) - values[i]) <= quantized.scale(0) / 2 * 1.001f;
+        }
+        util.assertEqual(withinHalfStep, true);
+        util.assertEqual(makeDense(quantized), quantized);
+    }
+    // 取值恰好为[-128, 127]中的整数时量化无损
+    {
+        Matrix<double> dense(16, 16);
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            for (std::size_t j = 0; j < 16; ++j)
+            {
+                dense.setValue(i, j, static_cast<double>(i * 16 + j) - 128);
+            }
+        }
+        auto quantized = makeQuantized(dense);
+        util.assertEqual(quantized.scale(0), 1);
+        util.assertEqual(quantized.zeroPoint(0), 0);
+        util.assertEqual(quantized, dense);
+        util.assertEqual(makeQuantized(dense.transpose()), dense.transpose());
+    }
+    // 每行一组量化参数
+    {
+        Matrix<float> dense(3, 256);
+        for (std::size_t j = 0; j < 256; ++j)
+        {
+            dense.setValue(0, j, static_cast<float>(j));
+            dense.setValue(1, j, 0);
+            dense.setValue(2, j, -2.0f * j / 255);
+        }
+        auto quantized = makeQuantized<QuantizeTags::PerRow>(dense);
+        static_assert(decltype(quantized)::PerRow);
+        util.assertEqual(quantized.scale(0), 1);
+        util.assertEqual(quantized.zeroPoint(0), -128);
+        util.assertEqual(quantized.scale(1), 1);
+        util.assertEqual(quantized.zeroPoint(1), 0);
+        util.assertEqual(quantized.scale(2), 2.0f / 255);
+        util.assertEqual(quantized.zeroPoint(2), 127);
+        util.assertEqual(quantized(0, 200), 200);
+        util.assertEqual(quantized(1, 17), 0);
+        util.assertEqual(std::abs(quantized(2, 100) - dense(2, 100)) < 1e-6f, true);
+    }
+    util.showGroupResult();
+}
+
+void test_tiled_matrix(TestUtil& util)
+{
+    util.setTestGroup("data.tiled_matrix");
+    {
+        TiledMatrix<double, DeviceTags::CPU, 4> mat(6, 9);
+        util.assertEqual(mat.rowNum(), 6);
+        util.assertEqual(mat.colNum(), 9);
+        util.assertEqual(mat.tileRowNum(), 2);
+        util.assertEqual(mat.tileColNum(), 3);
+        util.assertEqual(mat(5, 8), 0);
+        mat.setValue(5, 8, 3);
+        mat.setValue(1, 6, 2);
+        util.assertEqual(mat(5, 8), 3);
+        // 块内按行紧密排列，边缘块的填充部分为0
+        util.assertEqual(mat.tile(1, 2)(1, 0), 3);
+        util.assertEqual(mat.tile(0, 1)(1, 2), 2);
+        util.assertEqual(mat.tile(1, 2)(3, 3), 0);
+        util.assertEqual(mat.tile(1, 2).rowStride(), 4);
+        // 写时复制
+        auto mat2 = mat;
+        util.assertEqual(mat.availableForWrite(), false);
+        mat2.setValue(0, 0, -1);
+        util.assertEqual(mat2(0, 0), -1);
+        util.assertEqual(mat(0, 0), 0);
+        util.assertEqual(mat2(5, 8), 3);
+    }
+    // 与按行存储的矩阵互相转换，以及转置
+    {
+        Matrix<double> dense(7, 10);
+        iota(dense);
+        auto tiled = makeTiled<4>(dense);
+        static_assert(std::same_as<decltype(tiled), TiledMatrix<double, DeviceTags::CPU, 4>>);
+        util.assertEqual(tiled, dense);
+        util.assertEqual(tiled(6, 9), 69);
+        util.assertEqual(makeDense(tiled), dense);
+        util.assertEqual(makeTiled<4>(dense.transpose()), dense.transpose());
+        util.assertEqual(makeTiled<4>(dense.subMatrix(2, 7, 3, 10)), dense.subMatrix(2, 7, 3, 10));
+        auto trans = tiled.transpose();
+        util.assertEqual(trans.rowNum(), 10);
+        util.assertEqual(trans, dense.transpose());
+        util.assertEqual(trans.tile(2, 1)(1, 3), 0);
+        util.assertEqual(makeTiled(dense), dense);
+    }
     util.showGroupResult();
 }
 
@@ -291,6 +1456,76 @@ void test_array(TestUtil& util)
         util.assertEqual(arr2.size(), 2);
         util.assertEqual(arr2[0], mat);
     }
+    // evaluate: gather into a contiguous batch, cached until mutation
+    {
+        Array<Matrix<double>> arr(4, 5);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            Matrix<double> mat(4, 5);
+            iota(mat);
+            mat.setValue(0, 0, -100.0 * b);
+            arr.push_back(mat);
+        }
+        const auto& carr = arr;
+        util.assertEqual(carr.materialized(), false);
+        auto packed = evaluate(carr);
+        util.assertEqual(carr.materialized(), true);
+        util.assertEqual(packed.batchNum(), 3);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(packed[b], carr[b]);
+        }
+        // cached result is shared with copies and reused
+        util.assertEqual(evaluate(carr).view().data(), packed.view().data());
+        {
+            auto copy = carr;
+            util.assertEqual(copy.materialized(), true);
+            util.assertEqual(evaluate(copy).view().data(), packed.view().data());
+        }
+        // operators consume the packed batch
+        auto sum = evaluate(carr + carr);
+        util.assertEqual(sum.batchNum(), 3);
+        util.assertEqual(sum[2](3, 4), 2 * carr[2](3, 4));
+
+        // parallel gather gives the same result, including more threads than matrices
+        for (std::size_t threadNum : {1, 2, 5})
+        {
+            auto gathered = carr.gather(threadNum);
+            for (std::size_t b = 0; b < 3; ++b)
+            {
+                util.assertEqual(gathered[b], carr[b]);
+            }
+        }
+
+        Matrix<double> extra(4, 5);
+        iota(extra);
+        extra.setValue(1, 2, -50.0);
+        arr.push_back(extra);
+        util.assertEqual(carr.materialized(), false);
+        auto packed2 = evaluate(carr);
+        util.assertEqual(packed2.batchNum(), 4);
+        util.assertEqual(packed2[3], extra);
+        util.assertEqual(packed.batchNum(), 3);
+
+        arr[0] = extra;
+        util.assertEqual(carr.materialized(), false);
+        util.assertEqual(evaluate(carr)[0], extra);
+
+        arr.clear();
+        util.assertEqual(evaluate(carr).batchNum(), 0);
+    }
+    // evaluate array of scalars
+    {
+        Array<Scalar<double>> arr;
+        arr.push_back(1.5);
+        arr.push_back(-2.0);
+        auto packed = evaluate(std::as_const(arr));
+        util.assertEqual(packed.batchNum(), 2);
+        util.assertEqual(packed[1], -2.0);
+        arr.push_back(3.0);
+        util.assertEqual(std::as_const(arr).materialized(), false);
+        util.assertEqual(evaluate(std::as_const(arr))[2], 3.0);
+    }
     util.showGroupResult();
 }
 
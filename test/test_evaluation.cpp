@@ -1,13 +1,751 @@
+#include <evaluate/evaluate.hpp>
+#include <operator/add.hpp>
+#include <operator/subtract.hpp>
+#include <operator/element_mul.hpp>
+#include <operator/divide.hpp>
+#include <operator/abs.hpp>
+#include <operator/dot.hpp>
+#include <operator/transpose.hpp>
+#include <operator/sign.hpp>
+#include <operator/sigmoid.hpp>
+#include <operator/tanh.hpp>
+#include <operator/sigmoid_derivation.hpp>
+#include <operator/tanh_derivation.hpp>
+#include <operator/interpolation.hpp>
+#include <operator/softmax.hpp>
+#include <operator/softmax_derivation.hpp>
+#include <operator/collapse.hpp>
+#include <operator/quantize.hpp>
+#include <operator/negative_log_likelihood.hpp>
+#include <operator/negative_log_likelihood_derivation.hpp>
+#include <data/float16.hpp>
+#include <data/matrix/matrix.hpp>
+#include <data/matrix/fixed_matrix.hpp>
+#include <data/matrix/sparse_matrix.hpp>
+#include <data/matrix/quantized_matrix.hpp>
+#include <data/matrix/tiled_matrix.hpp>
+#include <data/matrix/trivial_matrix.hpp>
+#include <data/matrix/zero_matrix.hpp>
+#include <data/matrix/one_hot_vector.hpp>
+#include <data/batch/batch.hpp>
+#include <data/batch/batch_sparse_matrix.hpp>
+#include <data/batch/batch_one_hot_vector.hpp>
+#include <data/batch/duplicate.hpp>
+#include <data/batch/interleaved_batch.hpp>
+#include <data/batch/ragged_batch.hpp>
+
+#include <vector>
+#include <cmath>
+#include <limits>
+
 #include "test.hpp"
 
-// using namespace MetaNN;
+using namespace MetaNN;
+
+// 用动态形状矩阵的元素填充编译期形状矩阵
+template<typename TElem, std::size_t Rows, std::size_t Cols>
+FixedMatrix<TElem, Rows, Cols> toFixed(const Matrix<TElem>& mat)
+{
+    FixedMatrix<TElem, Rows, Cols> res;
+    for (std::size_t i = 0; i < Rows; ++i)
+    {
+        for (std::size_t j = 0; j < Cols; ++j)
+        {
+            res.setValue(i, j, mat(i, j));
+        }
+    }
+    return res;
+}
+
+// 朴素的矩阵乘法，作为参照
+template<typename TMatrix1, typename TMatrix2>
+Matrix<double> naiveDot(const TMatrix1& mat1, const TMatrix2& mat2)
+{
+    Matrix<double> res(mat1.rowNum(), mat2.colNum());
+    for (std::size_t i = 0; i < mat1.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < mat2.colNum(); ++j)
+        {
+            double sum = 0;
+            for (std::size_t k = 0; k < mat1.colNum(); ++k)
+            {
+                sum += mat1(i, k) * mat2(k, j);
+            }
+            res.setValue(i, j, sum);
+        }
+    }
+    return res;
+}
+
+// 16位浮点矩阵与float矩阵的元素在给定相对误差内相等
+template<typename TMatrix>
+bool approxEqual(const TMatrix& mat, const Matrix<float>& ref, float tolerance)
+{
+    for (std::size_t i = 0; i < ref.rowNum(); ++i)
+    {
+        for (std::size_t j = 0; j < ref.colNum(); ++j)
+        {
+            if (std::abs(float(mat(i, j)) - ref(i, j)) > tolerance * std::max(1.0f, std::abs(ref(i, j))))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 16位浮点元素的各个运算，与float计算结果比较
+template<typename TElem>
+void test_half_precision(TestUtil& util, float tolerance)
+{
+    Matrix<float> ref1(3, 4);
+    Matrix<float> ref2(3, 4);
+    Matrix<TElem> mat1(3, 4);
+    Matrix<TElem> mat2(3, 4);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 4; ++j)
+        {
+            // 取16位浮点可以精确表示的值
+            float val1 = float(TElem(0.25f * (i * 4 + j) - 1.3f));
+            float val2 = float(TElem(0.5f + 0.125f * j));
+            ref1.setValue(i, j, val1);
+            ref2.setValue(i, j, val2);
+            mat1.setValue(i, j, TElem(val1));
+            mat2.setValue(i, j, TElem(val2));
+        }
+    }
+    auto res = evaluate(mat1 + mat2 * mat2 - mat1 / mat2);
+    static_assert(std::same_as<decltype(res), Matrix<TElem>>);
+    util.assertEqual(approxEqual(res, evaluate(ref1 + ref2 * ref2 - ref1 / ref2), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(abs(mat1)), evaluate(abs(ref1)), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(sign(mat1)), evaluate(sign(ref1)), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(sigmoid(mat1)), evaluate(sigmoid(ref1)), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(tanh(mat1)), evaluate(tanh(ref1)), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(transpose(mat1)), ref1.transpose(), 0), true);
+    util.assertEqual(approxEqual(evaluate(dot(mat1, transpose(mat2))), evaluate(dot(ref1, transpose(ref2))), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(sigmoidDerivation(mat1, mat2)), evaluate(sigmoidDerivation(ref1, ref2)), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(tanhDerivation(mat1, mat2)), evaluate(tanhDerivation(ref1, ref2)), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(interpolation(mat1, mat2, mat2)), evaluate(interpolation(ref1, ref2, ref2)), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(vecSoftmax(mat1)), evaluate(vecSoftmax(ref1)), tolerance), true);
+    util.assertEqual(approxEqual(evaluate(vecSoftmaxDerivation(mat1, mat2)), evaluate(vecSoftmaxDerivation(ref1, ref2)), tolerance), true);
+
+    // 在float中累加：4096个1相加，16位浮点逐次累加会停在2048（Float16）或256（BFloat16）以下
+    Matrix<TElem> ones(1, 4096);
+    for (auto row : ones.mutableView())
+    {
+        std::ranges::fill(row, TElem(1.0f));
+    }
+    util.assertEqual(float(evaluate(dot(ones, ones.transpose()))(0, 0)), 4096.0f);
+    Batch<TElem, DeviceTags::CPU, CategoryTags::Matrix> batch(4096, 1, 2);
+    for (std::size_t b = 0; b < 4096; ++b)
+    {
+        batch.setValue(b, 0, 0, TElem(1.0f));
+        batch.setValue(b, 0, 1, TElem(-0.5f));
+    }
+    auto sum = evaluate(collapse(batch));
+    util.assertEqual(float(sum(0, 0)), 4096.0f);
+    util.assertEqual(float(sum(0, 1)), -2048.0f);
 
+    // softmax在float中求和：4096个相同的输入各得1/4096；导数中的内积为1，结果为0
+    Matrix<TElem> zeros(1, 4096);
+    for (auto row : zeros.mutableView())
+    {
+        std::ranges::fill(row, TElem(0.0f));
+    }
+    auto soft = evaluate(vecSoftmax(zeros));
+    util.assertEqual(float(soft(0, 0)), 1.0f / 4096);
+    util.assertEqual(float(soft(0, 4095)), 1.0f / 4096);
+    util.assertEqual(float(evaluate(vecSoftmaxDerivation(ones, soft))(0, 7)), 0.0f);
+}
 
 void test_evaluation(TestUtil& util)
 {
     util.setTestGroup("evaluation");
+    // 逐元素运算
     {
+        Matrix<double> mat1(3, 4);
+        Matrix<double> mat2(3, 4);
+        iota(mat1);
+        iota(mat2);
+        mat2.setValue(0, 0, 1);
+        auto res = evaluate(mat1 + mat2 * mat2 - mat1 / mat2);
+        static_assert(std::same_as<decltype(res), Matrix<double>>);
+        util.assertEqual(res(2, 3), 11 + 121 - 1.0);
+        util.assertEqual(res(0, 0), 1);
+        util.assertEqual(evaluate(abs(mat1 - mat2))(1, 2), 0);
+        // 转置视图参与运算
+        Matrix<double> mat3(4, 3);
+        iota(mat3);
+        util.assertEqual(evaluate(mat3.transpose() + mat1)(1, 2), 7 + 6);
+        util.assertEqual(evaluate(transpose(mat3)), mat3.transpose());
+    }
+    // 编译期形状的矩阵：结果也是编译期形状，且与动态形状的计算结果一致
+    {
+        Matrix<double> mat1(4, 4);
+        Matrix<double> mat2(4, 4);
+        iota(mat1);
+        iota(mat2);
+        auto fixed1 = toFixed<double, 4, 4>(mat1);
+        auto fixed2 = toFixed<double, 4, 4>(mat2);
+        auto sum = evaluate(fixed1 + fixed2 * fixed2);
+        static_assert(std::same_as<decltype(sum), FixedMatrix<double, 4, 4>>);
+        util.assertEqual(sum, evaluate(mat1 + mat2 * mat2));
+        auto prod = evaluate(dot(fixed1, fixed2));
+        static_assert(std::same_as<decltype(prod), FixedMatrix<double, 4, 4>>);
+        util.assertEqual(prod, naiveDot(mat1, mat2));
+        auto trans = evaluate(transpose(fixed1));
+        static_assert(std::same_as<decltype(trans), FixedMatrix<double, 4, 4>>);
+        util.assertEqual(trans, mat1.transpose());
+        // 与动态形状的矩阵混合时使用通用实现
+        auto mixed = evaluate(fixed1 + mat2);
+        static_assert(std::same_as<decltype(mixed), Matrix<double>>);
+        util.assertEqual(mixed, evaluate(mat1 + mat2));
+    }
+    // 激活函数的导数、插值与softmax：矩阵、编译期形状的矩阵与矩阵列表
+    {
+        Matrix<double> grad(2, 3);
+        Matrix<double> out(2, 3);
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            grad.setValue(i / 3, i % 3, 0.5 * i - 1);
+            out.setValue(i / 3, i % 3, 0.1 * (i + 1));
+        }
+        auto sigmoidGrad = evaluate(sigmoidDerivation(grad, out));
+        auto tanhGrad = evaluate(tanhDerivation(grad, out));
+        auto interp = evaluate(interpolation(grad, out, out));
+        auto soft = evaluate(vecSoftmax(grad));
+        auto softGrad = evaluate(vecSoftmaxDerivation(grad, soft));
+        static_assert(std::same_as<decltype(soft), Matrix<double>>);
+        bool match = true;
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            double rowSum = 0;
+            double weighted = 0;
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                const double g = grad(i, j);
+                const double y = out(i, j);
+                match = match && std::abs(sigmoidGrad(i, j) - g * y * (1 - y)) < 1e-12;
+                match = match && std::abs(tanhGrad(i, j) - g * (1 - y * y)) < 1e-12;
+                match = match && std::abs(interp(i, j) - (g * y + y * (1 - y))) < 1e-12;
+                rowSum += soft(i, j);
+                weighted += g * soft(i, j);
+            }
+            match = match && std::abs(rowSum - 1) < 1e-12;
+            match = match && std::abs(soft(i, 1) / soft(i, 0) - std::exp(0.5)) < 1e-12;
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                match = match && std::abs(softGrad(i, j) - soft(i, j) * (grad(i, j) - weighted)) < 1e-12;
+            }
+        }
+        util.assertEqual(match, true);
+        // 减去行内最大值，输入很大时不溢出
+        Matrix<double> large(1, 2);
+        large.setValue(0, 0, 1000);
+        large.setValue(0, 1, 1001);
+        util.assertEqual(std::abs(evaluate(vecSoftmax(large))(0, 1) - std::exp(1.0) / (1 + std::exp(1.0))) < 1e-12, true);
+
+        auto fixedGrad = toFixed<double, 2, 3>(grad);
+        auto fixedOut = toFixed<double, 2, 3>(out);
+        auto fixedSoft = evaluate(vecSoftmax(fixedGrad));
+        static_assert(std::same_as<decltype(fixedSoft), FixedMatrix<double, 2, 3>>);
+        util.assertEqual(fixedSoft, soft);
+        util.assertEqual(evaluate(vecSoftmaxDerivation(fixedGrad, fixedSoft)), softGrad);
+        auto fixedSigmoidGrad = evaluate(sigmoidDerivation(fixedGrad, fixedOut));
+        static_assert(std::same_as<decltype(fixedSigmoidGrad), FixedMatrix<double, 2, 3>>);
+        util.assertEqual(fixedSigmoidGrad, sigmoidGrad);
+        util.assertEqual(evaluate(tanhDerivation(fixedGrad, fixedOut)), tanhGrad);
+        util.assertEqual(evaluate(interpolation(fixedGrad, fixedOut, fixedOut)), interp);
 
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch(2, 2, 3);
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                batch.setValue(0, i, j, grad(i, j));
+                batch.setValue(1, i, j, out(i, j));
+            }
+        }
+        auto batchSoft = evaluate(vecSoftmax(batch));
+        util.assertEqual(batchSoft[0], soft);
+        util.assertEqual(evaluate(vecSoftmaxDerivation(batch, batchSoft))[0], softGrad);
+        util.assertEqual(evaluate(tanhDerivation(batch, batch))[1], evaluate(tanhDerivation(out, out)));
+        util.assertEqual(evaluate(interpolation(batch, batch, batch))[0], evaluate(interpolation(grad, grad, grad)));
+    }
+    // 矩阵乘法
+    {
+        Matrix<double> mat1(3, 5);
+        Matrix<double> mat2(5, 2);
+        iota(mat1);
+        iota(mat2);
+        auto ref = naiveDot(mat1, mat2);
+        util.assertEqual(evaluate(dot(mat1, mat2)), ref);
+        // 右操作数为转置视图：内积实现
+        Matrix<double> mat2T(2, 5);
+        iota(mat2T);
+        util.assertEqual(evaluate(dot(mat1, mat2T.transpose())), naiveDot(mat1, mat2T.transpose()));
+        // 左操作数为转置视图
+        Matrix<double> mat1T(5, 3);
+        iota(mat1T);
+        util.assertEqual(evaluate(dot(mat1T.transpose(), mat2)), naiveDot(mat1T.transpose(), mat2));
+        // 子矩阵与嵌套表达式
+        util.assertEqual(evaluate(dot(mat1.subMatrix(1, 3, 0, 5), mat2 + mat2)),
+                         naiveDot(mat1.subMatrix(1, 3, 0, 5), evaluate(mat2 + mat2)));
+        auto fixed1 = toFixed<double, 3, 5>(mat1);
+        auto fixed2 = toFixed<double, 5, 2>(mat2);
+        auto fixedProd = evaluate(dot(fixed1, fixed2));
+        static_assert(std::same_as<decltype(fixedProd), FixedMatrix<double, 3, 2>>);
+        util.assertEqual(fixedProd, ref);
+    }
+    // 稀疏矩阵与稠密矩阵
+    {
+        Matrix<double> dense1(4, 6);
+        iota(dense1);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            for (std::size_t j = 0; j < 6; ++j)
+            {
+                if ((i + j) % 3 != 0)
+                {
+                    dense1.setValue(i, j, 0);
+                }
+            }
+        }
+        auto sparse1 = makeSparse(dense1);
+        Matrix<double> mat2(6, 3);
+        iota(mat2);
+        auto prod = evaluate(dot(sparse1, mat2));
+        static_assert(std::same_as<decltype(prod), Matrix<double>>);
+        util.assertEqual(prod, naiveDot(dense1, mat2));
+        util.assertEqual(evaluate(dot(sparse1, mat2 + mat2)), naiveDot(dense1, evaluate(mat2 + mat2)));
+        Matrix<double> mat2T(3, 6);
+        iota(mat2T);
+        util.assertEqual(evaluate(dot(sparse1, mat2T.transpose())), naiveDot(dense1, mat2T.transpose()));
+        // 稠密矩阵乘稀疏矩阵
+        Matrix<double> mat3(2, 4);
+        iota(mat3);
+        util.assertEqual(evaluate(dot(mat3, sparse1)), naiveDot(mat3, dense1));
+        util.assertEqual(evaluate(dot(mat3.transpose().transpose(), sparse1)), naiveDot(mat3, dense1));
+        // 稀疏矩阵列表
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch1(2, 4, 6);
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch2(2, 6, 3);
+        iota(batch2);
+        auto dest = batch1.mutableView();
+        for (std::size_t b = 0; b < 2; ++b)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                for (std::size_t j = 0; j < 6; ++j)
+                {
+                    dest(b, i, j) = (i + j + b) % 4 == 0 ? static_cast<double>(i * 6 + j) : 0;
+                }
+            }
+        }
+        auto sparseBatch = makeSparse(batch1);
+        auto batchProd = evaluate(dot(sparseBatch, batch2));
+        for (std::size_t b = 0; b < 2; ++b)
+        {
+            util.assertEqual(batchProd[b], naiveDot(batch1[b], batch2[b]));
+        }
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch3(2, 3, 4);
+        iota(batch3);
+        auto batchProd3 = evaluate(dot(batch3, sparseBatch));
+        for (std::size_t b = 0; b < 2; ++b)
+        {
+            util.assertEqual(batchProd3[b], naiveDot(batch3[b], batch1[b]));
+        }
+        // 稀疏矩阵与稠密矩阵列表：稀疏矩阵被转换为重复列表
+        auto sharedLeft = evaluate(dot(sparse1, batch2));
+        auto sharedRight = evaluate(dot(batch3, sparse1));
+        static_assert(std::same_as<decltype(sharedRight), Batch<double, DeviceTags::CPU, CategoryTags::Matrix>>);
+        for (std::size_t b = 0; b < 2; ++b)
+        {
+            util.assertEqual(sharedLeft[b], naiveDot(dense1, batch2[b]));
+            util.assertEqual(sharedRight[b], naiveDot(batch3[b], dense1));
+        }
+        // 其他运算使用展开后的稠密矩阵
+        util.assertEqual(evaluate(sparse1), dense1);
+        util.assertEqual(evaluate(transpose(sparse1)), evaluate(transpose(dense1)));
+        util.assertEqual(evaluate(sparse1 + dense1), evaluate(dense1 + dense1));
+        util.assertEqual(evaluate(sparseBatch)[1], batch1[1]);
+    }
+    // 矩阵列表
+    {
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch1(3, 2, 4);
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch2(3, 4, 2);
+        iota(batch1);
+        iota(batch2);
+        auto sum = evaluate(batch1 + batch1);
+        util.assertEqual(sum.batchNum(), 3);
+        util.assertEqual(sum[2](1, 3), 2 * batch1[2](1, 3));
+        auto prod = evaluate(dot(batch1, batch2));
+        util.assertEqual(prod.rowNum(), 2);
+        util.assertEqual(prod.colNum(), 2);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            util.assertEqual(prod[i], naiveDot(batch1[i], batch2[i]));
+        }
+        util.assertEqual(evaluate(dot(batch1, batch1.transpose()))[1], naiveDot(batch1[1], batch1[1].transpose()));
+    }
+    // 分块矩阵
+    {
+        Matrix<double> mat1(7, 10);
+        Matrix<double> mat2(10, 5);
+        iota(mat1);
+        iota(mat2);
+        auto tiled1 = makeTiled<4>(mat1);
+        auto tiled2 = makeTiled<4>(mat2);
+        auto prod = evaluate(dot(tiled1, tiled2));
+        static_assert(std::same_as<decltype(prod), TiledMatrix<double, DeviceTags::CPU, 4>>);
+        util.assertEqual(prod, naiveDot(mat1, mat2));
+        util.assertEqual(prod.tile(1, 1)(3, 3), 0);
+        // 反向传播中的转置乘法
+        auto trans = evaluate(transpose(tiled1));
+        static_assert(std::same_as<decltype(trans), TiledMatrix<double, DeviceTags::CPU, 4>>);
+        util.assertEqual(trans, mat1.transpose());
+        util.assertEqual(evaluate(dot(transpose(tiled1), tiled1)), naiveDot(mat1.transpose(), mat1));
+        util.assertEqual(evaluate(dot(tiled2, transpose(tiled2))), naiveDot(mat2, mat2.transpose()));
+    }
+    // int8量化
+    {
+        // 取值恰好覆盖量化区间的整数时量化无损，int8乘法的结果与浮点乘法完全一致
+        // mat1在[0, 255]中（zeroPoint为-128），mat2在[-128, 127]中（zeroPoint为0）
+        Matrix<double> mat1(4, 6);
+        Matrix<double> mat2(6, 5);
+        for (std::size_t i = 0; i < 24; ++i)
+        {
+            mat1.setValue(i / 6, i % 6, static_cast<double>(i * 255 / 23));
+        }
+        for (std::size_t i = 0; i < 30; ++i)
+        {
+            mat2.setValue(i / 5, i % 5, static_cast<double>(i * 255 / 29) - 128);
+        }
+        auto ref = naiveDot(mat1, mat2);
+        auto prod = evaluate(dot(quantize(mat1), quantize(mat2)));
+        static_assert(std::same_as<decltype(prod), Matrix<double>>);
+        util.assertEqual(prod, ref);
+        auto quantized2 = evaluate(quantize(mat2));
+        static_assert(QuantizedMatrixC<decltype(quantized2)>);
+        util.assertEqual(evaluate(dot(quantize(abs(mat1)), quantized2)), ref);
+        util.assertEqual(evaluate(dequantize(quantize(mat1))), mat1);
+        util.assertEqual(evaluate(dequantize(quantized2)), mat2);
+        // 每行一组量化参数：第i行的取值范围为[0, 255 * (i + 1)]
+        Matrix<double> mat3(3, 6);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 6; ++j)
+            {
+                mat3.setValue(i, j, static_cast<double>(j * 51 * (i + 1)));
+            }
+        }
+        util.assertEqual(evaluate(dot(quantize<QuantizeTags::PerRow>(mat3), quantized2)), naiveDot(mat3, mat2));
+        // 一般的取值：与float乘法结果的误差在sum_k(|a(i, k) * b(k, j)|)的1%以内
+        Matrix<float> mat4(8, 64);
+        Matrix<float> mat5(64, 16);
+        for (std::size_t i = 0; i < 8 * 64; ++i)
+        {
+            mat4.setValue(i / 64, i % 64, std::sin(0.37f * i));
+        }
+        for (std::size_t i = 0; i < 64 * 16; ++i)
+        {
+            mat5.setValue(i / 16, i % 16, std::cos(0.11f * i) * 0.5f);
+        }
+        auto floatProd = evaluate(dot(mat4, mat5));
+        auto quantizedProd = evaluate(dot(quantize<QuantizeTags::PerRow>(mat4), quantize(mat5)));
+        auto absProd = evaluate(dot(abs(mat4), abs(mat5)));
+        float maxAbs = 0;
+        float maxErr = 0;
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            for (std::size_t j = 0; j < 16; ++j)
+            {
+                maxAbs = std::max(maxAbs, absProd(i, j));
+                maxErr = std::max(maxErr, std::abs(floatProd(i, j) - quantizedProd(i, j)));
+            }
+        }
+        util.assertEqual(maxErr < 0.01f * maxAbs, true);
+
+        // 零点修正后的结果超出int32：取值范围为[0, 1]时每项修正后的乘积为255 * 255
+        constexpr std::size_t LongMidNum = 40000;
+        Matrix<double> mat6(1, LongMidNum);
+        Matrix<double> mat7(LongMidNum, 1);
+        for (std::size_t k = 0; k < LongMidNum; ++k)
+        {
+            mat6.setValue(0, k, k == 0 ? 0.0 : 1.0);
+            mat7.setValue(k, 0, k == 1 ? 0.0 : 1.0);
+        }
+        auto longProd = evaluate(dot(quantize(mat6), quantize(mat7)));
+        util.assertEqual(std::abs(longProd(0, 0) - (LongMidNum - 2)) < 1e-6 * LongMidNum, true);
+
+        // 超过int32累加上限的中间维度：取值范围为[-1, 0]时-1量化为-128，每项乘积为128 * 128
+        constexpr std::size_t MaxMidNum = std::numeric_limits<std::int32_t>::max() / (128 * 128);
+        for (std::size_t midNum : {MaxMidNum, MaxMidNum + 1, 2 * MaxMidNum + 3})
+        {
+            Matrix<double> mat8(1, midNum);
+            Matrix<double> mat9(midNum, 1);
+            for (std::size_t k = 0; k < midNum; ++k)
+            {
+                mat8.setValue(0, k, -1.0);
+                mat9.setValue(k, 0, -1.0);
+            }
+            auto boundaryProd = evaluate(dot(quantize(mat8), quantize(mat9)));
+            util.assertEqual(std::abs(boundaryProd(0, 0) - static_cast<double>(midNum)) < 1e-6 * midNum, true);
+        }
+    }
+    // 平凡矩阵、全零矩阵与独热向量：逐元素运算与矩阵乘法不展开为稠密矩阵
+    {
+        Matrix<double> mat1(3, 4);
+        Matrix<double> mat2(4, 2);
+        for (std::size_t i = 0; i < 12; ++i)
+        {
+            mat1.setValue(i / 4, i % 4, static_cast<double>(i) - 5);
+        }
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            mat2.setValue(i / 2, i % 2, static_cast<double>(i * i));
+        }
+        TrivialMatrix<double> trivial1(3, 4, 1.5);
+        TrivialMatrix<double> trivial2(4, 2, 2.0);
+        ZeroMatrix<double> zero1(3, 4);
+        ZeroMatrix<double> zero2(4, 2);
+
+        auto sum = evaluate(Scalar<double>(1.5) + mat1);
+        auto diff = evaluate(trivial1 - mat1);
+        auto prod = evaluate(mat1 * zero1);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 4; ++j)
+            {
+                util.assertEqual(sum(i, j), mat1(i, j) + 1.5);
+                util.assertEqual(diff(i, j), 1.5 - mat1(i, j));
+                util.assertEqual(prod(i, j), 0.0);
+            }
+        }
+        util.assertEqual(evaluate(trivial1 + mat1), sum);
+        util.assertEqual(trivial1.materialized(), false);
+        util.assertEqual(zero1.materialized(), false);
+
+        util.assertEqual(evaluate(dot(trivial1, mat2)), naiveDot(evaluate(trivial1), mat2));
+        util.assertEqual(evaluate(dot(mat1, trivial2)), naiveDot(mat1, evaluate(trivial2)));
+        util.assertEqual(evaluate(dot(transpose(mat2), transpose(trivial1))),
+                         naiveDot(evaluate(transpose(mat2)), evaluate(transpose(evaluate(trivial1)))));
+        util.assertEqual(evaluate(dot(mat1, zero2)), naiveDot(mat1, evaluate(zero2)));
+        util.assertEqual(evaluate(dot(zero1, mat2)), naiveDot(evaluate(zero1), mat2));
+
+        OneHotVector<double> hot1(4, 2);
+        OneHotVector<double> hot2(2, 1);
+        util.assertEqual(evaluate(dot(hot1, mat2)), naiveDot(evaluate(hot1), mat2));
+        Matrix<double> col(3, 1);
+        col.setValue(0, 0, 1.0);
+        col.setValue(1, 0, -2.0);
+        col.setValue(2, 0, 4.0);
+        util.assertEqual(evaluate(dot(col, hot2)), naiveDot(col, evaluate(hot2)));
+        util.assertEqual(hot1.materialized(), true);
+
+        // 需要稠密形式时只生成一次，拷贝之间共享
+        auto dense1 = evaluate(trivial1);
+        util.assertEqual(trivial1.materialized(), true);
+        TrivialMatrix<double> trivialCopy = trivial1;
+        util.assertEqual(lowerAccess(evaluate(trivialCopy)).rawMemory(), lowerAccess(dense1).rawMemory());
+    }
+    // 独热向量列表：矩阵乘法按位置取行，负对数似然及其导数只访问hotPos处的元素
+    {
+        Matrix<double> weight(5, 3);
+        for (std::size_t i = 0; i < 15; ++i)
+        {
+            weight.setValue(i / 3, i % 3, static_cast<double>(i) * 0.5 - 2);
+        }
+        std::vector<std::size_t> positions{4, 0, 2};
+        BatchOneHotVector<double> labels(5, positions);
+        auto dense = evaluate(labels);
+        auto embedded = evaluate(dot(labels, weight));
+        util.assertEqual(embedded.batchNum(), 3);
+        util.assertEqual(embedded.rowNum(), 1);
+        util.assertEqual(embedded.colNum(), 3);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(embedded[b], naiveDot(dense[b], weight));
+        }
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> weights(3, 5, 3);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            for (std::size_t i = 0; i < 15; ++i)
+            {
+                weights.setValue(b, i / 3, i % 3, static_cast<double>(i * (b + 1)));
+            }
+        }
+        auto batchEmbedded = evaluate(dot(labels, weights));
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(batchEmbedded[b], naiveDot(dense[b], weights[b]));
+        }
+
+        // 预测值：每行为正数
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> pred(3, 1, 5);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            for (std::size_t j = 0; j < 5; ++j)
+            {
+                pred.setValue(b, 0, j, 0.05 * static_cast<double>(b + j + 1));
+            }
+        }
+        auto loss = evaluate(negativeLogLikelihood(labels, pred));
+        auto denseLoss = evaluate(negativeLogLikelihood(dense, pred));
+        util.assertEqual(loss.batchNum(), 3);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(std::abs(loss[b] + std::log(pred[b](0, positions[b]))) < 1e-12, true);
+            util.assertEqual(std::abs(loss[b] - denseLoss[b]) < 1e-12, true);
+        }
+        auto singleLoss = evaluate(negativeLogLikelihood(labels[1], pred[1]));
+        util.assertEqual(std::abs(singleLoss.value() + std::log(pred[1](0, 0))) < 1e-12, true);
+
+        Batch<double, DeviceTags::CPU, CategoryTags::Scalar> grad(3);
+        grad.setValue(0, 1.0);
+        grad.setValue(1, 0.5);
+        grad.setValue(2, -2.0);
+        auto deriv = evaluate(negativeLogLikelihoodDerivation(grad, labels, pred));
+        auto denseDeriv = evaluate(negativeLogLikelihoodDerivation(grad, dense, pred));
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(deriv[b], denseDeriv[b]);
+            util.assertEqual(deriv[b](0, positions[b]), -grad[b] / pred[b](0, positions[b]));
+        }
+        auto singleDeriv = evaluate(negativeLogLikelihoodDerivation(Scalar<double>(0.5), labels[1], pred[1]));
+        util.assertEqual(singleDeriv, denseDeriv[1]);
+    }
+    // 重复列表：求值为矩阵间隔为0的列表，矩阵与矩阵列表的运算不复制矩阵
+    {
+        Matrix<double> mat(4, 3);
+        iota(mat);
+        auto shared = evaluate(makeDuplicate(3, mat));
+        util.assertEqual(shared.batchNum(), 3);
+        util.assertEqual(shared.view().isShared(), true);
+        util.assertEqual(shared.view().data(), mat.view().data());
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(shared[b], mat);
+        }
+        // 写入时各矩阵先分离，不影响其他矩阵与被重复的矩阵
+        shared.setValue(1, 0, 0, -1.0);
+        util.assertEqual(shared.view().isShared(), false);
+        util.assertEqual(shared[0], mat);
+        util.assertEqual(shared[1](0, 0), -1.0);
+        util.assertEqual(mat(0, 0), 0.0);
+
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch1(3, 2, 4);
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch2(3, 3, 4);
+        iota(batch1);
+        iota(batch2);
+        Matrix<double> matT(3, 4);
+        iota(matT);
+        auto prod = evaluate(dot(batch1, mat));
+        auto prodT = evaluate(dot(batch1, matT.transpose()));
+        auto prodStrided = evaluate(dot(batch2.transpose(), matT));
+        auto prodLeft = evaluate(dot(matT, batch2.transpose()));
+        auto prodLeftT = evaluate(dot(mat.transpose(), batch2.transpose()));
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(prod[b], naiveDot(batch1[b], mat));
+            util.assertEqual(prodT[b], naiveDot(batch1[b], matT.transpose()));
+            util.assertEqual(prodStrided[b], naiveDot(batch2[b].transpose(), matT));
+            util.assertEqual(prodLeft[b], naiveDot(matT, batch2[b].transpose()));
+            util.assertEqual(prodLeftT[b], naiveDot(mat.transpose(), batch2[b].transpose()));
+        }
+        auto prodBoth = evaluate(dot(makeDuplicate(3, matT), makeDuplicate(3, mat)));
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(prodBoth[b], naiveDot(matT, mat));
+        }
+
+        Matrix<double> bias(2, 4);
+        iota(bias);
+        auto sum = evaluate(bias + batch1);
+        auto shifted = evaluate(Scalar<double>(0.5) + batch1);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            util.assertEqual(sum[b](1, 3), bias(1, 3) + batch1[b](1, 3));
+            util.assertEqual(shifted[b](1, 2), batch1[b](1, 2) + 0.5);
+        }
+        util.assertEqual(bias(1, 3), 7.0);
+    }
+    // 批次交错存储的矩阵列表：逐元素运算与矩阵乘法沿批次方向计算，结果保持批次交错存储
+    {
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch1(7, 2, 3);
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch2(7, 3, 2);
+        iota(batch1);
+        iota(batch2);
+        const auto inter1 = makeInterleaved(batch1);
+        const auto inter2 = makeInterleaved(batch2);
+
+        auto sum = evaluate(tanh(inter1 + inter1));
+        static_assert(InterleavedBatchC<decltype(sum)>);
+        auto denseSum = evaluate(tanh(batch1 + batch1));
+        for (std::size_t b = 0; b < 7; ++b)
+        {
+            util.assertEqual(sum[b], denseSum[b]);
+        }
+
+        auto prod = evaluate(dot(inter1, inter2));
+        static_assert(InterleavedBatchC<decltype(prod)>);
+        Matrix<double> weight(3, 4);
+        iota(weight);
+        auto prodRight = evaluate(dot(inter1, weight));
+        auto prodLeft = evaluate(dot(weight.transpose(), inter2));
+        static_assert(InterleavedBatchC<decltype(prodRight)>);
+        for (std::size_t b = 0; b < 7; ++b)
+        {
+            util.assertEqual(prod[b], naiveDot(batch1[b], batch2[b]));
+            util.assertEqual(prodRight[b], naiveDot(batch1[b], weight));
+            util.assertEqual(prodLeft[b], naiveDot(weight.transpose(), batch2[b]));
+        }
+
+        // 与按矩阵存储的列表混合时使用一般的实现
+        auto mixed = evaluate(inter1 + batch1);
+        util.assertEqual(mixed[6](1, 2), 2 * batch1[6](1, 2));
+    }
+    // 变长矩阵列表：逐元素运算在所有行上计算，与矩阵、矩阵列表相乘都不填充
+    {
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> padded(3, 4, 3);
+        iota(padded);
+        const std::vector<std::size_t> rowNums{2, 4, 1};
+        const auto ragged = makeRagged(padded, rowNums);
+
+        auto sum = evaluate(tanh(ragged + ragged));
+        static_assert(RaggedBatchC<decltype(sum)>);
+        util.assertEqual(sum.sameSegments(ragged), true);
+        auto denseSum = evaluate(tanh(padded + padded));
+        auto shifted = evaluate(Scalar<double>(0.5) + ragged);
+        static_assert(RaggedBatchC<decltype(shifted)>);
+
+        Matrix<double> weight(3, 2);
+        iota(weight);
+        auto prodRight = evaluate(dot(ragged, weight));
+        static_assert(RaggedBatchC<decltype(prodRight)>);
+        util.assertEqual(prodRight.totalRowNum(), 7);
+        Batch<double, DeviceTags::CPU, CategoryTags::Matrix> batch2(3, 3, 2);
+        iota(batch2);
+        auto prodBatch = evaluate(dot(ragged, batch2));
+        static_assert(RaggedBatchC<decltype(prodBatch)>);
+        for (std::size_t b = 0; b < 3; ++b)
+        {
+            for (std::size_t i = 0; i < rowNums[b]; ++i)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    util.assertEqual(sum[b](i, j), denseSum[b](i, j));
+                    util.assertEqual(shifted[b](i, j), padded[b](i, j) + 0.5);
+                }
+            }
+            util.assertEqual(prodRight[b], naiveDot(ragged[b], weight));
+            util.assertEqual(prodBatch[b], naiveDot(ragged[b], batch2[b]));
+        }
+    }
+    // 16位浮点元素
+    {
+        test_half_precision<Float16>(util, 2e-3f);
+        test_half_precision<BFloat16>(util, 1.6e-2f);
     }
     util.showGroupResult();
-}
\ No newline at end of file
+}
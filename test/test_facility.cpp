@@ -51,5 +51,14 @@ void test_facility_data_copy(TestUtil& util)
         util.assertEqual(mat1, mat2);
         util.assertEqual(mat1.availableForWrite(), true);
     }
+    // 转置视图按元素复制
+    {
+        Matrix<double> mat1(3, 4);
+        iota(mat1);
+        Matrix<double> mat2(4, 3);
+        dataCopy(mat1.transpose(), mat2);
+        util.assertEqual(mat2, mat1.transpose());
+        util.assertEqual(lowerAccess(mat2).colStride(), 1);
+    }
     util.showGroupResult();
 }
@@ -14,7 +14,13 @@ void test_param_initializer(TestUtil& util)
 {
     util.setTestGroup("parameter initializer");
     {
-
+        Matrix<double> mat(3, 4);
+        ConstantFiller filler(1.5);
+        filler.fill(mat, 0, 0);
+        util.assertEqual(mat(2, 3), 1.5);
+        auto trans = Matrix<double>(3, 4).transpose();
+        filler.fill(trans, 0, 0);
+        util.assertEqual(trans(3, 2), 1.5);
     }
     util.showGroupResult();
 }